@@ -0,0 +1,23 @@
+#
+# CYANCORE LICENSE
+# Copyrights (C) 2026, Cyancore Team
+#
+# File Name		: build.mk
+# Description		: This file builds and gathers project properties
+# Primary Author	: agent [agent@local]
+# Organisation		: Cyancore Core-Team
+#
+
+PROJECT_DIR	:= $(GET_PATH)
+
+OPTIMIZATION	:= s
+
+EXE_MODE	:= terravisor
+
+include $(PROJECT_DIR)/config.mk
+
+DIR		:= $(PROJECT_DIR)
+include mk/obj.mk
+
+aux_target:
+	make qemu_sifive_e_bl DEBUG=0
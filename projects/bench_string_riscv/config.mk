@@ -0,0 +1,22 @@
+#
+# CYANCORE LICENSE
+# Copyrights (C) 2026, Cyancore Team
+#
+# File Name		: config.mk
+# Description		: This file consists of project config
+# Primary Author	: agent [agent@local]
+# Organisation		: Cyancore Core-Team
+#
+
+COMPILER	:= gcc
+FAMILY		:= sifive
+PLATFORM	:= qemu-sifive-e
+STDLOG_MEMBUF	:= 0
+BOOTMSGS        := 0
+EARLYCON_SERIAL	:= 1
+CONSOLE_SERIAL	:= 1
+OBRDLED_ENABLE	:= 0
+TERRAKERN	:= 0
+
+# Build with RV_STRING_ASM=1 to measure asm memcpy/memset
+RV_STRING_ASM	?= 0
@@ -0,0 +1,168 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: project.c
+ * Description		: This file consists of benchmark of libc string
+ *			  functions against plain byte loops
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <status.h>
+#include <stdio.h>
+#include <string.h>
+#include <arch.h>
+#include <terravisor/bootstrap.h>
+#include <driver.h>
+
+#define BUF_SIZE	1024
+#define N_RUNS		16
+
+static uint8_t buf_a[BUF_SIZE + 8] _ALIGN(4);
+static uint8_t buf_b[BUF_SIZE + 8] _ALIGN(4);
+
+static inline uint32_t read_cycles()
+{
+	uint32_t c;
+	asm volatile("csrr %0, mcycle" : "=r" (c));
+	return c;
+}
+
+/* Reference byte loops, as libc had them */
+static _NOINLINE void *byte_memcpy(void *i, const void *j, size_t size)
+{
+	const volatile char *src = j;
+	volatile char *dst = i;
+	while(size--)
+		*dst++ = *src++;
+	return i;
+}
+
+static _NOINLINE void *byte_memset(void *i, int n, size_t size)
+{
+	volatile char *p = i;
+	while(size--)
+		*p++ = n;
+	return i;
+}
+
+static _NOINLINE int byte_memcmp(const void *i, const void *j, size_t size)
+{
+	int ret = 0;
+	const volatile unsigned char *s = i;
+	const volatile unsigned char *d = j;
+	while(size--)
+	{
+		ret = (*s++);
+		ret -= (*d++);
+		if(ret)
+			return ret;
+	}
+	return ret;
+}
+
+static _NOINLINE size_t byte_strlen(const char *i)
+{
+	const volatile char *p = i;
+	while(*p)
+		p++;
+	return (p - i);
+}
+
+typedef enum
+{
+	op_memcpy,
+	op_memmove,
+	op_memset,
+	op_memcmp,
+	op_strlen,
+} bench_op_t;
+
+static const char * const op_name[] =
+{
+	"memcpy", "memmove", "memset", "memcmp", "strlen"
+};
+
+static uint32_t run(bench_op_t op, bool ref, size_t off, size_t size)
+{
+	uint32_t start, total = 0;
+	unsigned int i;
+
+	for(i = 0; i < N_RUNS; i++)
+	{
+		start = read_cycles();
+		switch(op)
+		{
+			case op_memcpy:
+				ref ? byte_memcpy(buf_a + off, buf_b, size) :
+					memcpy(buf_a + off, buf_b, size);
+				break;
+			case op_memmove:
+				ref ? byte_memcpy(buf_a + off, buf_a + 4, size) :
+					memmove(buf_a + off, buf_a + 4, size);
+				break;
+			case op_memset:
+				ref ? byte_memset(buf_a + off, 0x5a, size) :
+					memset(buf_a + off, 0x5a, size);
+				break;
+			case op_memcmp:
+				ref ? byte_memcmp(buf_a + off, buf_b + off, size) :
+					memcmp(buf_a + off, buf_b + off, size);
+				break;
+			case op_strlen:
+				ref ? byte_strlen((char *)buf_b + off) :
+					strlen((char *)buf_b + off);
+				break;
+		}
+		total += read_cycles() - start;
+	}
+	return total / N_RUNS;
+}
+
+static void bench(bench_op_t op, size_t off, size_t size)
+{
+	uint32_t ref, lib;
+
+	/* strlen and memcmp walk buffers which match till the end */
+	memset(buf_b, 'a', sizeof(buf_b));
+	buf_b[off + size] = '\0';
+	memcpy(buf_a, buf_b, sizeof(buf_a));
+
+	ref = run(op, true, off, size);
+	lib = run(op, false, off, size);
+	printf("%s\t%u B +%u: byte %u cyc, libc %u cyc, x%u.%02u\n",
+		op_name[op], (unsigned int)size, (unsigned int)off,
+		(unsigned int)ref, (unsigned int)lib,
+		lib ? (unsigned int)(ref / lib) : 0,
+		lib ? (unsigned int)(((ref % lib) * 100) / lib) : 0);
+}
+
+void plug()
+{
+	static const size_t sizes[] = {8, 64, 256, BUF_SIZE};
+	unsigned int op, i;
+
+	bootstrap();
+	driver_setup_all();
+
+	printf("String benchmark, %u runs averaged (asm: %u)\n",
+		N_RUNS, RV_STRING_ASM);
+	for(op = op_memcpy; op <= op_strlen; op++)
+	{
+		for(i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+		{
+			bench(op, 0, sizes[i]);
+			bench(op, 3, sizes[i]);
+		}
+	}
+	return;
+}
+
+void play()
+{
+	arch_wfi();
+	return;
+}
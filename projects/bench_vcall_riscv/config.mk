@@ -0,0 +1,20 @@
+#
+# CYANCORE LICENSE
+# Copyrights (C) 2026, Cyancore Team
+#
+# File Name		: config.mk
+# Description		: This file consists of project config
+# Primary Author	: agent [agent@local]
+# Organisation		: Cyancore Core-Team
+#
+
+COMPILER	:= gcc
+FAMILY		:= sifive
+PLATFORM	:= qemu-sifive-e
+STDLOG_MEMBUF	:= 0
+BOOTMSGS        := 0
+EARLYCON_SERIAL	:= 1
+CONSOLE_SERIAL	:= 1
+OBRDLED_ENABLE	:= 0
+TERRAKERN	:= 0
+VCALL_DIRECT	:= 1
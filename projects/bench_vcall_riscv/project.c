@@ -0,0 +1,91 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: project.c
+ * Description		: This file consists of benchmark of visor call
+ *			  trap path against direct call path
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <status.h>
+#include <stdio.h>
+#include <arch.h>
+#include <visor_call.h>
+#include <visor/workers.h>
+#include <resource.h>
+#include <terravisor/bootstrap.h>
+#include <driver.h>
+
+#define N_RUNS		64
+
+static inline uint32_t read_cycles()
+{
+	uint32_t c;
+	asm volatile("csrr %0, mcycle" : "=r" (c));
+	return c;
+}
+
+/* Trap path, same as arch_visor_call without VCALL_DIRECT */
+static void trap_call(unsigned int code, unsigned int arg0, vret_t *ret)
+{
+	register uint32_t a0 asm("a0") = code;
+	register uint32_t a1 asm("a1") = arg0;
+	register uint32_t a2 asm("a2") = 0;
+	register uint32_t a3 asm("a3") = 0;
+	asm volatile("ecall"
+				: "+r" (a0), "+r" (a1), "+r"(a2)
+				: "r" (a0), "r" (a1), "r" (a2), "r" (a3)
+				: "memory");
+	ret->p = a0;
+	ret->size = a1;
+	ret->status = a2;
+}
+
+static uint32_t bench(bool trap, unsigned int code, unsigned int arg0)
+{
+	vret_t vres;
+	uint32_t start, total = 0;
+	unsigned int i;
+
+	for(i = 0; i < N_RUNS; i++)
+	{
+		start = read_cycles();
+		if(trap)
+			trap_call(code, arg0, &vres);
+		else
+			arch_visor_call(code, arg0, 0, 0, &vres);
+		total += read_cycles() - start;
+	}
+	return total / N_RUNS;
+}
+
+static void report(const char *name, unsigned int code, unsigned int arg0)
+{
+	uint32_t t, d;
+	t = bench(true, code, arg0);
+	d = bench(false, code, arg0);
+	printf("%s: ecall %u cyc, arch_visor_call %u cyc\n",
+		name, (unsigned int)t, (unsigned int)d);
+}
+
+void plug()
+{
+	bootstrap();
+	driver_setup_all();
+
+	printf("VCall benchmark, %u runs averaged (direct: %u)\n",
+		N_RUNS, VCALL_DIRECT);
+	report("fetch_sp", fetch_sp, console_uart);
+	report("fetch_dp", fetch_dp, uart);
+	report("invalid ", 0, 0);
+	return;
+}
+
+void play()
+{
+	arch_wfi();
+	return;
+}
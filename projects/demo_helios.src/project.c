@@ -28,9 +28,9 @@ void plug()
 	driver_setup_all();
 
 	syslog(info, "Demo HELIOS!\n");
-	helios_add_task(&Task_A, "Task A", &task_handler, (helios_args)NULL, 5, 255, (uintptr_t) NULL);
-	helios_add_task(&Task_B, "Task B", &task_handler, (helios_args)NULL, 7, 255, (uintptr_t) NULL);
-	helios_add_task(&Task_C, "Task C", &task_handler, (helios_args)NULL, 4, 255, (uintptr_t) NULL);
+	helios_add_task(&Task_A, "Task A", &task_handler, (helios_args)NULL, 5, DEMO_TASK_STACK_LEN, (uintptr_t) NULL);
+	helios_add_task(&Task_B, "Task B", &task_handler, (helios_args)NULL, 7, DEMO_TASK_STACK_LEN, (uintptr_t) NULL);
+	helios_add_task(&Task_C, "Task C", &task_handler, (helios_args)NULL, 4, DEMO_TASK_STACK_LEN, (uintptr_t) NULL);
 	helios_run();
 }
 
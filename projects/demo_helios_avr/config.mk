@@ -11,7 +11,7 @@
 COMPILER	:= gcc
 FAMILY		:= mega_avr
 PLATFORM	:= atmega328p
-HEAP_SIZE 	:= 500
+HEAP_SIZE 	:= 1K
 STACK_SIZE 	:= 256
 STDLOG_MEMBUF	:= 0
 BOOTMSGS	:= 0
@@ -11,7 +11,7 @@
 COMPILER	:= gcc
 FAMILY		:= sifive
 PLATFORM	:= fe310g002
-HEAP_SIZE 	:= 3K
+HEAP_SIZE 	:= 6K
 STACK_SIZE 	:= 1K
 STDLOG_MEMBUF	:= 1
 BOOTMSGS	:= 1
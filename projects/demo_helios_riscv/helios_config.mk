@@ -11,6 +11,11 @@
 HELIOS_USE_DYNAMIC 		:= 1
 HELIOS_HEAP_SIZE 		:= 1024
 HELIOS_MAX_THREAD 		:= 4
-HELIOS_IDLE_TASK_STACK_LEN 	:= 255
+HELIOS_PRIORITY_LEVELS		:= 8
+HELIOS_IDLE_TASK_STACK_LEN 	:= 512
 HELIOS_POWER_SAVE_EN 		:= 0
 HELIOS_ANTI_DEADLOCK		:= 0
+
+# Stack of each demo task, holds task context when switched out
+DEMO_TASK_STACK_LEN		:= 1024
+$(eval $(call add_define,DEMO_TASK_STACK_LEN))
@@ -17,3 +17,4 @@ EARLYCON_SERIAL	:= 1
 CONSOLE_SERIAL	:= 1
 OBRDLED_ENABLE	:= 1
 TERRAKERN	:= 0
+VCALL_DIRECT	:= 1
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 #include <status.h>
 #include <syslog.h>
@@ -33,6 +34,15 @@ void arch_early_setup()
 	MMIO8(MCUCR) = 0;
 	MMIO8(SMCR) = 0;
 	MMIO8(WDTCSR) = 0;
+#if BOOT_TRACE || IRQ_STATS
+	/* Free running timer1 @ FCLK/ARCH_CYCLES_DIV for arch_read_cycles */
+	MMIO8(TCCR1A) = 0;
+#if IRQ_STATS
+	MMIO8(TCCR1B) = (1 << 1);
+#else
+	MMIO8(TCCR1B) = (1 << 2) | (1 << 0);
+#endif
+#endif
 	return;
 }
 
@@ -57,6 +67,37 @@ void arch_ei_restore_state(const istate_t *sreg_i_backup)
 	MMIO8(SREG+0x20) |= *sreg_i_backup;
 }
 
+/**
+ * arch_ctx_init - Prepares stack for new execution context
+ *
+ * @brief This function builds a switch frame at the top of
+ * the stack such that arch_ctx_switch "returns" into entry
+ * with global interrupts enabled.
+ *
+ * @param[in] stack_base: Lowest address of the stack
+ * @param[in] stack_len: Length of the stack in bytes
+ * @param[in] entry: Function to be executed by the context
+ * @return sp: Stack pointer to be passed to arch_ctx_switch
+ */
+uintptr_t arch_ctx_init(uintptr_t stack_base, size_t stack_len, void (*entry)(void))
+{
+	uint8_t *sp = (uint8_t *)(stack_base + stack_len - 1);
+	uint16_t pc = (uint16_t)(uintptr_t) entry;
+
+	/* Return address, popped by ret */
+	*sp-- = (uint8_t)(pc & 0xff);
+	*sp-- = (uint8_t)((pc >> 8) & 0xff);
+#ifdef __AVR_3_BYTE_PC__
+	*sp-- = 0;
+#endif
+	/* r2-r17, r28 & r29 */
+	sp -= 18;
+	memset(sp + 1, 0, 18);
+	/* SREG with I bit set */
+	*sp-- = (1 << 7);
+	return (uintptr_t) sp;
+}
+
 /**
  * arch_wfi - wait for interrupt
  *
@@ -35,6 +35,16 @@ void arch_wfi();
 void arch_di_save_state(istate_t *);
 void arch_ei_restore_state(const istate_t *);
 
+/**
+ * arch_ctx_init - Prepares a stack to be switched into
+ * arch_ctx_switch - Saves current context and switches stack
+ * arch_register_irq_exit_hook - Registers function to be called
+ * at the end of each interrupt, used for deferred context switch
+ */
+uintptr_t arch_ctx_init(uintptr_t, size_t, void (*)(void));
+void arch_ctx_switch(uintptr_t *, uintptr_t);
+void arch_register_irq_exit_hook(void (*)(void));
+
 /**
  * arch_panic_handler - Executes when arch error occurs
  */
@@ -55,6 +65,25 @@ static inline unsigned int arch_core_index()
 	return 0;
 }
 
+/**
+ * arch_read_cycles - Returns free running counter
+ *
+ * @brief AVR has no cycle counter, timer1 is left free running
+ * at FCLK/ARCH_CYCLES_DIV for boot trace and irq stats. Counter is
+ * 16 bit wide, users need to account for wrap using ARCH_CYCLES_MASK.
+ * IRQ stats need finer ticks, so timer1 runs at FCLK/8 with it.
+ */
+#define ARCH_CYCLES_MASK	0xffffUL
+#if IRQ_STATS
+#define ARCH_CYCLES_DIV		8
+#else
+#define ARCH_CYCLES_DIV		1024
+#endif
+static inline unsigned long arch_read_cycles()
+{
+	return MMIO16(TCNT1);
+}
+
 /**
  * arch_visor_call - perform machine call
  *
@@ -17,8 +17,10 @@
 #include <arch.h>
 #include <plat_arch.h>
 #include <platform.h>
+#include <irqstat.h>
 
 static context_frame_t *local_frame;
+static void (* irq_exit_hook)(void);
 
 bool in_isr(void)
 {
@@ -64,6 +66,20 @@ void arch_register_interrupt_handler(unsigned int id, void (* handler)(void))
 	int_handler[id] = handler;
 }
 
+/**
+ * arch_register_irq_exit_hook - Registers interrupt exit hook
+ *
+ * @brief This function registers a function which is executed
+ * after every interrupt handler with interrupts still disabled.
+ * It is used by kernels to perform deferred context switch.
+ *
+ * @param[in] *hook: function pointer of the hook
+ */
+void arch_register_irq_exit_hook(void (* hook)(void))
+{
+	irq_exit_hook = hook;
+}
+
 /**
  * interrupt_handler - Executes int ID correspoding interrupt handler
  *
@@ -75,6 +91,7 @@ void arch_register_interrupt_handler(unsigned int id, void (* handler)(void))
  */
 void interrupt_handler(unsigned char id, context_frame_t *frame)
 {
+	unsigned long t_entry = irqstat_stamp(), t_start;
 	set_context_frame(frame);
 
 	/* Check for valid interrupt ID */
@@ -94,7 +111,9 @@ void interrupt_handler(unsigned char id, context_frame_t *frame)
 		assert(handler);
 
 		/* Execute interrupt handler */
+		t_start = irqstat_stamp();
 		handler();
+		irqstat_record(int_arch, id + 1, t_entry, t_start, irqstat_stamp());
 	}
 	else if(id == 254)
 		plat_panic_handler_callback();
@@ -102,6 +121,8 @@ void interrupt_handler(unsigned char id, context_frame_t *frame)
 		arch_panic_handler_callback();
 	else{}
 	set_context_frame(NULL);
+	if(irq_exit_hook)
+		irq_exit_hook();
 	return;
 }
 
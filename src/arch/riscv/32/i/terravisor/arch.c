@@ -10,6 +10,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include <status.h>
 #include <syslog.h>
 #include <arch.h>
@@ -62,9 +63,7 @@ void arch_early_setup()
 	arch_di_mei();
 	arch_di_mtime();
 	arch_di_msoftirq();
-#ifndef RV_VEC_MODE
 	riscv_update_vector();
-#endif
 	return;
 }
 
@@ -85,18 +84,47 @@ void arch_setup2()
 	return;
 }
 
+/*
+ * Only global interrupt enable (mstatus.MIE) is saved and cleared,
+ * mie is left untouched so that wfi can still wake up on pending
+ * interrupts while in critical section.
+ */
 void arch_di_save_state(istate_t *istate)
 {
-	istate_t temp;
-	asm volatile("csrr %0, mie" : "=r" (temp));
-	*istate = temp & (1 << 3 | 1 << 7 | 1 << 11);
-	arch_di();
+	istate_t bits = (1 << 3);
+	asm volatile("csrrc %0, mstatus, %1" : "=r" (*istate) : "r" (bits));
+	*istate &= bits;
 }
 
 void arch_ei_restore_state(istate_t *istate)
 {
-	asm volatile("csrs mie, %0" : : "r" (*istate));
-	arch_ei();
+	asm volatile("csrs mstatus, %0" : : "r" (*istate));
+}
+
+/**
+ * arch_ctx_init - Prepares stack for new execution context
+ *
+ * @brief This function builds a switch frame at the top of
+ * the stack such that arch_ctx_switch "returns" into entry
+ * with machine interrupts enabled.
+ *
+ * @param[in] stack_base: Lowest address of the stack
+ * @param[in] stack_len: Length of the stack in bytes
+ * @param[in] entry: Function to be executed by the context
+ * @return sp: Stack pointer to be passed to arch_ctx_switch
+ */
+uintptr_t arch_ctx_init(uintptr_t stack_base, size_t stack_len, void (*entry)(void))
+{
+	uintptr_t sp = (stack_base + stack_len) & ~((uintptr_t) 0xf);
+	switch_frame_t *frame;
+
+	sp -= sizeof(switch_frame_t);
+	frame = (switch_frame_t *) sp;
+	memset(frame, 0, sizeof(switch_frame_t));
+	frame->ra = (uint32_t) entry;
+	/* MPP = M-mode, MPIE & MIE set */
+	frame->mstatus = (3 << 11) | (1 << 7) | (1 << 3);
+	return sp;
 }
 
 static cpu_sleep_t sleep_flag[N_CORES];
@@ -12,5 +12,13 @@ RV32I_T_ARCH_DIR	:= $(GET_PATH)
 
 $(eval $(call add_include,$(RV32I_T_ARCH_DIR)/include/))
 
+# Call visor directly instead of ecall, only when callers run in m mode
+VCALL_DIRECT	?= 0
+$(eval $(call add_define,VCALL_DIRECT))
+
+# Use hand written memcpy/memset in place of generic libc ones
+RV_STRING_ASM	?= 0
+$(eval $(call add_define,RV_STRING_ASM))
+
 DIR		:= $(RV32I_T_ARCH_DIR)
 include mk/obj.mk
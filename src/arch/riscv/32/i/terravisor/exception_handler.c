@@ -15,28 +15,41 @@
 #include <assert.h>
 #include <arch.h>
 #include <mmio.h>
+#include <irqstat.h>
 
 static void (* exhandler[N_CORES][N_EXCEP])(void) = {{[0 ... N_EXCEP-1] = arch_panic_handler}};
 static void (* irqhandler[N_CORES][N_IRQ])(void) = {{[0 ... N_IRQ-1] = arch_unhandled_irq}};
-static context_frame_t *local_frame[N_CORES];
+/* Frame and exit hook are also used by riscv_fast_irq in asm */
+context_frame_t *riscv_local_frame[N_CORES];
+void (* riscv_irq_exit_hook[N_CORES])(void);
+#if RV_VEC_MODE
+/* 16 handlers per core */
+#define RV_N_FAST_IRQ	16
+void (* riscv_fast_irqhandler[N_CORES][RV_N_FAST_IRQ])(void);
+uint32_t riscv_in_fast_irq[N_CORES];
+#endif
 
 bool in_isr(void)
 {
 	unsigned int cpuid = arch_core_index();
-	return (local_frame[cpuid] != NULL) ? true : false;
+#if RV_VEC_MODE
+	if(riscv_in_fast_irq[cpuid])
+		return true;
+#endif
+	return (riscv_local_frame[cpuid] != NULL) ? true : false;
 }
 
 static void set_context_frame(context_frame_t *frame)
 {
 	unsigned int cpuid = arch_core_index();
-	local_frame[cpuid] = frame;
+	riscv_local_frame[cpuid] = frame;
 	fence(w, w);
 }
 
 context_frame_t *get_context_frame(void)
 {
 	unsigned int cpuid = arch_core_index();
-	return local_frame[cpuid];
+	return riscv_local_frame[cpuid];
 }
 
 void arch_register_interrupt_handler(unsigned int id, void (*handler)(void))
@@ -55,20 +68,65 @@ void local_register_interrupt_handler(unsigned int id, void (*handler)(void))
 	fence(ow, ow);
 }
 
+/**
+ * local_register_fast_handler - Registers fast interrupt handler
+ *
+ * @brief In vectored mode, handler is called straight from the vector
+ * with only caller saved registers, mepc and mstatus stacked, skipping
+ * context frame bookkeeping and two level lookup. It runs with interrupts
+ * masked and in_isr() reads true. Irq exit hook is called on leaving
+ * the outermost trap as in generic path, so deferred context switch
+ * works. Context frame is not available to the handler. Passing NULL
+ * falls back to handler registered by local_register_interrupt_handler.
+ * Without vectored mode handler is registered as a regular one.
+ *
+ * @param[in] id: local interrupt id (1-15)
+ * @param[in] handler: fast handler
+ */
+void local_register_fast_handler(unsigned int id, void (*handler)(void))
+{
+#if RV_VEC_MODE
+	unsigned int cpuid = arch_core_index();
+	assert(id && id < RV_N_FAST_IRQ);
+	riscv_fast_irqhandler[cpuid][id] = handler;
+	fence(ow, ow);
+#else
+	local_register_interrupt_handler(id, handler ? handler : &arch_unhandled_irq);
+#endif
+}
+
+void arch_register_irq_exit_hook(void (*hook)(void))
+{
+	unsigned int cpuid = arch_core_index();
+	riscv_irq_exit_hook[cpuid] = hook;
+	fence(ow, ow);
+}
+
 void exception_handler(uint32_t mcause, context_frame_t *frame)
 {
+	unsigned long t_prev = irqstat_trap_enter(), t_start;
 	unsigned int cause = mcause & ~(1U << 31);
 	unsigned int cpuid = arch_core_index();
+	/* Frame of the preempted handler, if nested */
+	context_frame_t *prev = riscv_local_frame[cpuid];
 
 	set_context_frame(frame);
 
 	if(mcause & (1U << 31))
+	{
+		t_start = irqstat_stamp();
 		irqhandler[cpuid][cause]();
+		irqstat_record(int_local, cause, irqstat_trap_stamp(), t_start, irqstat_stamp());
+	}
 	else
 	{
 		exhandler[cpuid][cause]();
 		frame->mepc += (MMIO8(frame->mepc) & 0x2) ? 4 : 2;
 	}
-	set_context_frame(NULL);
+	irqstat_trap_exit(t_prev);
+	set_context_frame(prev);
 	fence(ow, ow);
+	/* Context switch is allowed only when leaving the outermost trap */
+	if(prev == NULL && riscv_irq_exit_hook[cpuid] != NULL)
+		riscv_irq_exit_hook[cpuid]();
 }
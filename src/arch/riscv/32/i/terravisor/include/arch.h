@@ -27,8 +27,18 @@ void arch_early_setup();
 void arch_setup();
 void arch_setup2();
 
-void arch_di_save_state();
-void arch_ei_restore_state();
+void arch_di_save_state(istate_t *);
+void arch_ei_restore_state(istate_t *);
+
+/**
+ * arch_ctx_init - Prepares a stack to be switched into
+ * arch_ctx_switch - Saves current context and switches stack
+ * arch_register_irq_exit_hook - Registers function to be called
+ * at the end of each trap, used for deferred context switch
+ */
+uintptr_t arch_ctx_init(uintptr_t, size_t, void (*)(void));
+void arch_ctx_switch(uintptr_t *, uintptr_t);
+void arch_register_irq_exit_hook(void (*)(void));
 
 /**
  * arch_panic_handler - Executes when arch error occurs
@@ -52,6 +62,12 @@ void arch_register_interrupt_handler(unsigned int, void (*)(void));
  */
 void local_register_interrupt_handler(unsigned int, void (*)(void));
 
+/**
+ * local_register_fast_handler - Registers handler for cpu specific
+ * interrupt which is called with minimal context save in vectored mode
+ */
+void local_register_fast_handler(unsigned int, void (*)(void));
+
 /**
  * arch_core_index - Returns code index
  */
@@ -62,11 +78,25 @@ static inline unsigned int arch_core_index()
 	return id;
 }
 
+/**
+ * arch_read_cycles - Returns cycle counter (mcycle)
+ */
+#define ARCH_CYCLES_MASK	(~0UL)
+#define ARCH_CYCLES_DIV		1
+static inline unsigned long arch_read_cycles()
+{
+	unsigned long c;
+	asm volatile("csrr %0, mcycle" : "=r" (c));
+	return c;
+}
+
 /**
  * arch_visor_call - perform machine call
  *
  * @brief This function performs environment call
- * in m mode
+ * in m mode. With VCALL_DIRECT, caller is expected to run in
+ * m mode itself, so the trap is skipped and the handler is called
+ * directly with interrupts masked as they would be in the trap.
  *
  * @param[in] code: machine call code
  * @param[in] a0: first argument
@@ -78,6 +108,13 @@ static inline void arch_visor_call(unsigned int code, unsigned int arg0, unsigne
 {
 	if(ret == NULL)
 		return;
+#if VCALL_DIRECT
+	extern void vcall_handler(unsigned int, unsigned int, unsigned int, unsigned int, vret_t *);
+	istate_t state;
+	arch_di_save_state(&state);
+	vcall_handler(code, arg0, arg1, arg2, ret);
+	arch_ei_restore_state(&state);
+#else
 	register uint32_t a0 asm("a0") = code;
 	register uint32_t a1 asm("a1") = arg0;
 	register uint32_t a2 asm("a2") = arg1;
@@ -89,6 +126,7 @@ static inline void arch_visor_call(unsigned int code, unsigned int arg0, unsigne
 	ret->p = a0;
 	ret->size = a1;
 	ret->status = a2;
+#endif
 	return;
 }
 
@@ -25,6 +25,13 @@ typedef struct context_frame
 		 /* Padding is necessary for alignment */
 } context_frame_t;
 
+typedef struct switch_frame
+{
+	uint32_t ra, s0, s1, s2, s3, s4, s5, s6,
+		 s7, s8, s9, s10, s11, mstatus, pad[2];
+		 /* Padding is necessary for 16B stack alignment */
+} switch_frame_t;
+
 typedef uint32_t call_arg_t;
 typedef uint32_t istate_t;
 
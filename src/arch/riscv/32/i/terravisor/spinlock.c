@@ -15,18 +15,24 @@
 
 _WEAK void spinlock_acquire(volatile spinlock_t *key)
 {
+	istate_t istate;
+	/*
+	 * Interrupt state of the caller is restored instead of
+	 * enabling interrupts, so that lock can be used from ISR
+	 * and kernel critical sections.
+	 */
 	while(1)
 	{
-		arch_di();
+		arch_di_save_state(&istate);
 		if(!*key)
 		{
 			*key = 1;
 			fence(r, rw);
 			break;
 		}
-		arch_ei();
+		arch_ei_restore_state(&istate);
 	}
-	arch_ei();
+	arch_ei_restore_state(&istate);
 }
 
 _WEAK void spinlock_release(volatile spinlock_t *key)
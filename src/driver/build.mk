@@ -11,6 +11,15 @@
 
 DRIVER_PATH	:= $(GET_PATH)
 
+# Number of fetch_sp/fetch_dp results cached on driver side
+DEVPROP_CACHE_SIZE	?= 8
+$(eval $(call add_define,DEVPROP_CACHE_SIZE))
+
+# Slots in driver name index, must be power of 2 and
+# larger than number of drivers in the image
+DRIVER_INDEX_SIZE	?= 16
+$(eval $(call add_define,DRIVER_INDEX_SIZE))
+
 #==========< Essentials Drivers >==========#
 include $(DRIVER_PATH)/interrupt/build.mk
 include $(DRIVER_PATH)/watchdog/build.mk
@@ -45,6 +45,13 @@ static status_t earlycon_serial_write(const char c)
 	return ret;
 }
 
+static status_t earlycon_serial_write_buf(const char *buf, size_t len)
+{
+	while(len--)
+		uart_tx(earlycon_port, *buf++);
+	return success;
+}
+
 static console_t *earlycon_serial_driver;
 
 status_t earlycon_serial_driver_exit()
@@ -74,6 +81,10 @@ status_t earlycon_serial_driver_setup()
 		goto cleanup_1;
 	}
 	earlycon_serial_driver->write = &earlycon_serial_write;
+	earlycon_serial_driver->write_buf = &earlycon_serial_write_buf;
+	earlycon_serial_driver->read = NULL;
+	earlycon_serial_driver->flush = NULL;
+	earlycon_serial_driver->payload_size = NULL;
 
 	ret = earlycon_serial_setup();
 	if(ret)
@@ -17,6 +17,7 @@
 #include <lock/spinlock.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include <driver.h>
 #include <interrupt.h>
@@ -34,7 +35,7 @@ static status_t console_serial_setup()
 	const swdev_t *sp;
 	const module_t *dp;
 	hw_devid_t devid;
-	arch_visor_call(fetch_sp, console_uart, 0, 0, &vres);
+	devprop_fetch_sp(console_uart, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("Console could not found!\n");
@@ -42,7 +43,7 @@ static status_t console_serial_setup()
 	}
 	sp = (swdev_t *) vres.p;
 	devid = sp->hwdev_id;
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0x00ff), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0x00ff), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("UART Device %d not found!\n", devid);
@@ -61,6 +62,8 @@ static status_t console_serial_setup()
 	console_port->tx_handler = console_serial_write_irq_handler;
 	console_port->rx_irq = &dp->interrupt[0];
 	console_port->rx_handler = console_serial_read_irq_handler;
+	/* Input arriving while idle must not be lost */
+	console_port->rx_wake = true;
 
 	sysdbg2("UART engine @ %p\n", console_port->baddr);
 	sysdbg2("UART baud @ %lubps\n", console_port->baud);
@@ -72,40 +75,63 @@ static status_t console_serial_setup()
 	return uart_setup(console_port, trx, no_parity);
 }
 
-static int_wait_t con_write_wait;
+static completion_t con_write_done;
 
 static void console_serial_write_irq_handler()
 {
-	wait_release_on_irq(&con_write_wait);
+	completion_signal(&con_write_done);
 }
 
 status_t console_serial_write(const char c)
 {
 	status_t ret;
-	ret = wait_lock(&con_write_wait);
-	ret |= uart_tx(console_port, c);
-	ret |= wait_till_irq(&con_write_wait);
+	completion_init(&con_write_done);
+	ret = uart_tx(console_port, c);
+	ret |= completion_wait(&con_write_done);
 	return ret;
 }
 
-static int_wait_t con_read_wait;
+static status_t console_serial_write_buf(const char *buf, size_t len)
+{
+	status_t ret = success;
+	while(len--)
+		ret |= console_serial_write(*buf++);
+	return ret;
+}
+
+static completion_t con_read_done;
 static char con_char;
 
 static void console_serial_read_irq_handler()
 {
-	wait_release_on_irq(&con_read_wait);
 	uart_rx(console_port, &con_char);
+	completion_signal(&con_read_done);
 }
 
 static status_t console_serial_read(char *c)
 {
 	status_t ret;
-	ret = wait_lock(&con_read_wait);
-	ret |= wait_till_irq(&con_read_wait);
+	ret = completion_wait(&con_read_done);
 	*c = con_char;
 	return ret;
 }
 
+/*
+ * Write waits for Tx complete interrupt and read for Rx interrupt,
+ * neither would arrive with UART suspended, so veto while waiting.
+ */
+status_t console_serial_driver_suspend(void)
+{
+	if(completion_pending(&con_write_done) || completion_pending(&con_read_done))
+		return error_driver_busy;
+	return uart_suspend(console_port);
+}
+
+status_t console_serial_driver_resume(void)
+{
+	return uart_resume(console_port);
+}
+
 static console_t *console_serial_driver;
 
 status_t console_serial_driver_exit()
@@ -128,6 +154,9 @@ status_t console_serial_driver_setup()
 		return error_memory_low;
 	console_serial_driver->write = &console_serial_write;
 	console_serial_driver->read = &console_serial_read;
+	console_serial_driver->write_buf = &console_serial_write_buf;
+	console_serial_driver->flush = NULL;
+	console_serial_driver->payload_size = NULL;
 	ret = console_serial_setup();
 	if(ret)
 		goto cleanup_exit;
@@ -141,5 +170,6 @@ exit:
 }
 
 #if CONSOLE_SERIAL==1
-INCLUDE_DRIVER(console, console_serial_driver_setup, console_serial_driver_exit, 0, 255, 255);
+INCLUDE_DRIVER_PM(console, console_serial_driver_setup, console_serial_driver_exit,
+		console_serial_driver_suspend, console_serial_driver_resume, 0, 255, 255);
 #endif
@@ -17,6 +17,7 @@
 #include <lock/spinlock.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include <driver.h>
 #include <interrupt.h>
@@ -31,7 +32,7 @@ static status_t earlycon_serial_setup()
 	swdev_t *sp;
 	module_t *dp;
 	hw_devid_t devid;
-	arch_visor_call(fetch_sp, console_uart, 0, 0, &vres);
+	devprop_fetch_sp(console_uart, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("Console could not found!\n");
@@ -39,7 +40,7 @@ static status_t earlycon_serial_setup()
 	}
 	sp = (swdev_t *) vres.p;
 	devid = sp->hwdev_id;
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0x00ff), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0x00ff), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("UART Device %d not found!\n", devid);
@@ -73,6 +74,16 @@ static status_t earlycon_serial_write(const char c)
 	return ret;
 }
 
+/* Uses double buffered UDR and waits only once for the whole block */
+static status_t earlycon_serial_write_buf(const char *buf, size_t len)
+{
+	status_t ret = success;
+	while(len--)
+		ret |= uart_tx(earlycon_port, *buf++);
+	uart_tx_wait_till_done(earlycon_port);
+	return ret;
+}
+
 static console_t *earlycon_serial_driver;
 
 status_t earlycon_serial_driver_exit()
@@ -92,6 +103,10 @@ status_t earlycon_serial_driver_setup()
 	if(!earlycon_serial_driver)
 		return error_memory_low;
 	earlycon_serial_driver->write = &earlycon_serial_write;
+	earlycon_serial_driver->write_buf = &earlycon_serial_write_buf;
+	earlycon_serial_driver->read = NULL;
+	earlycon_serial_driver->flush = NULL;
+	earlycon_serial_driver->payload_size = NULL;
 	ret = earlycon_serial_setup();
 	if(ret)
 		goto cleanup_exit;
@@ -23,6 +23,11 @@
 #include <hal/uart.h>
 #include <driver/sysclk.h>
 #include <driver/console.h>
+#include <mempool.h>
+
+INCLUDE_MEMPOOL(console_serial_port_pool, uart_port_t, 1);
+INCLUDE_MEMPOOL(console_serial_driver_pool, console_t, 1);
+INCLUDE_MEMPOOL(console_serial_handle_pool, sysclk_config_clk_callback_t, 1);
 
 static uart_port_t *console_port;
 
@@ -37,6 +42,8 @@ static status_t console_serial_setup(void)
 		goto exit;
 
 	console_port->irq_handler = console_serial_irq_handler;
+	/* Input arriving while idle must not be lost */
+	console_port->rx_wake = true;
 
 	sysdbg2("UART engine @ %p\n", console_port->baddr);
 	sysdbg2("UART baud @ %lubps\n", console_port->baud);
@@ -58,18 +65,23 @@ static status_t console_serial_write(const char c)
 	return ret;
 }
 
-static int_wait_t con_read_wait;
+static status_t console_serial_write_buf(const char *buf, size_t len)
+{
+	status_t ret = success;
+	while(len--)
+		ret |= uart_tx(console_port, *buf++);
+	return ret;
+}
+
+static completion_t con_read_done;
 static char con_buff[32];
 static uint8_t wp, rp, occ;
 
 static status_t console_serial_read(char *c)
 {
 	status_t ret = success;
-	if(!occ)
-	{
-		ret = wait_lock(&con_read_wait);
-		ret |= wait_till_irq(&con_read_wait);
-	}
+	while(!occ)
+		ret |= completion_wait(&con_read_done);
 
 	*c = con_buff[wp++];
 	wp = wp % 32;
@@ -82,13 +94,13 @@ static void console_serial_irq_handler(void)
 {
 	if(uart_rx_pending(console_port))
 	{
-		wait_release_on_irq(&con_read_wait);
 		while(uart_rx_pending(console_port))
 		{
 			uart_rx(console_port, &con_buff[rp++]);
 			rp = rp % 32;
 			occ++;
 		}
+		completion_signal(&con_read_done);
 	}
 }
 
@@ -105,6 +117,22 @@ static status_t console_serial_post_clk_config(void)
 	return success;
 }
 
+/*
+ * Reader waits for Rx interrupt which would not arrive
+ * with UART suspended, so veto while it is waiting.
+ */
+status_t console_serial_driver_suspend(void)
+{
+	if(completion_pending(&con_read_done))
+		return error_driver_busy;
+	return uart_suspend(console_port);
+}
+
+status_t console_serial_driver_resume(void)
+{
+	return uart_resume(console_port);
+}
+
 static sysclk_config_clk_callback_t *console_handle;
 
 status_t console_serial_driver_exit(void)
@@ -115,9 +143,12 @@ status_t console_serial_driver_exit(void)
 		ret |= sysclk_deregister_config_clk_callback(console_handle);
 	if(console_port)
 		ret |= uart_shutdown(console_port);
-	free(console_port);
-	free(console_serial_driver);
-	free(console_handle);
+	mempool_free(&console_serial_port_pool, console_port);
+	mempool_free(&console_serial_driver_pool, console_serial_driver);
+	mempool_free(&console_serial_handle_pool, console_handle);
+	console_port = NULL;
+	console_serial_driver = NULL;
+	console_handle = NULL;
 	ret |= driver_setup("earlycon");
 	return ret;
 }
@@ -127,14 +158,14 @@ status_t console_serial_driver_setup(void)
 	status_t ret;
 	driver_exit("earlycon");
 
-	console_port = (uart_port_t *)malloc(sizeof(uart_port_t));
+	console_port = (uart_port_t *)mempool_alloc(&console_serial_port_pool);
 	if(!console_port)
 	{
 		ret = error_memory_low;
 		goto cleanup_1;
 	}
 
-	console_serial_driver = (console_t *)malloc(sizeof(console_t));
+	console_serial_driver = (console_t *)mempool_alloc(&console_serial_driver_pool);
 	if(!console_serial_driver)
 	{
 		ret = error_memory_low;
@@ -142,10 +173,11 @@ status_t console_serial_driver_setup(void)
 	}
 
 	console_serial_driver->write = &console_serial_write;
+	console_serial_driver->write_buf = &console_serial_write_buf;
 	console_serial_driver->read = &console_serial_read;
 	console_serial_driver->payload_size = (unsigned int *)&occ;
 
-	console_handle = (sysclk_config_clk_callback_t*)malloc(sizeof(sysclk_config_clk_callback_t));
+	console_handle = (sysclk_config_clk_callback_t*)mempool_alloc(&console_serial_handle_pool);
 	if(!console_handle)
 	{
 		ret = error_memory_low;
@@ -173,5 +205,7 @@ exit:
 }
 
 #if CONSOLE_SERIAL==1
-INCLUDE_DRIVER(console, console_serial_driver_setup, console_serial_driver_exit, 0, 255, 255);
+INCLUDE_DRIVER_PM_DEPS(console, console_serial_driver_setup, console_serial_driver_exit,
+		console_serial_driver_suspend, console_serial_driver_resume,
+		0, 255, 255, 0, "sysclk_prci", "riscv_plic");
 #endif
@@ -23,6 +23,11 @@
 #include <hal/uart.h>
 #include <driver/console.h>
 #include <driver/sysclk.h>
+#include <mempool.h>
+
+INCLUDE_MEMPOOL(earlycon_serial_port_pool, uart_port_t, 1);
+INCLUDE_MEMPOOL(earlycon_serial_driver_pool, console_t, 1);
+INCLUDE_MEMPOOL(earlycon_serial_handle_pool, sysclk_config_clk_callback_t, 1);
 
 static uart_port_t *earlycon_port;
 
@@ -47,6 +52,16 @@ static status_t earlycon_serial_write(const char c)
 	return ret;
 }
 
+/* Keeps tx fifo filled and waits only once for the whole block */
+static status_t earlycon_serial_write_buf(const char *buf, size_t len)
+{
+	status_t ret = success;
+	while(len--)
+		ret |= uart_tx(earlycon_port, *buf++);
+	uart_tx_wait_till_done(earlycon_port);
+	return ret;
+}
+
 static status_t earlycon_serial_pre_clk_config()
 {
 	return success;
@@ -70,8 +85,12 @@ status_t earlycon_serial_driver_exit()
 		ret |= sysclk_deregister_config_clk_callback(earlycon_handle);
 	if(earlycon_port)
 		ret |= uart_shutdown(earlycon_port);
-	free(earlycon_serial_driver);
-	free(earlycon_handle);
+	mempool_free(&earlycon_serial_port_pool, earlycon_port);
+	mempool_free(&earlycon_serial_driver_pool, earlycon_serial_driver);
+	mempool_free(&earlycon_serial_handle_pool, earlycon_handle);
+	earlycon_port = NULL;
+	earlycon_serial_driver = NULL;
+	earlycon_handle = NULL;
 	return ret;
 }
 
@@ -79,22 +98,23 @@ status_t earlycon_serial_driver_setup()
 {
 	status_t ret;
 
-	earlycon_port = (uart_port_t *)malloc(sizeof(uart_port_t));
+	earlycon_port = (uart_port_t *)mempool_alloc(&earlycon_serial_port_pool);
 	if(!earlycon_port)
 	{
 		ret = error_memory_low;
 		goto cleanup_1;
 	}
 
-	earlycon_serial_driver = (console_t *)malloc(sizeof(console_t));
+	earlycon_serial_driver = (console_t *)mempool_alloc(&earlycon_serial_driver_pool);
 	if(!earlycon_serial_driver)
 	{
 		ret = error_memory_low;
 		goto cleanup_1;
 	}
 	earlycon_serial_driver->write = &earlycon_serial_write;
+	earlycon_serial_driver->write_buf = &earlycon_serial_write_buf;
 
-	earlycon_handle = (sysclk_config_clk_callback_t *)malloc(sizeof(sysclk_config_clk_callback_t));
+	earlycon_handle = (sysclk_config_clk_callback_t *)mempool_alloc(&earlycon_serial_handle_pool);
 	if(!earlycon_handle)
 	{
 		ret = error_memory_low;
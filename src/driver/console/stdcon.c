@@ -57,8 +57,10 @@ status_t console_attach_device(status_t dev_status, console_t *pcon)
 		ret = dev_status;
 		console_attached = (ret == success) ? true : false;
 		ret |= stdout_register(&console_putc);
+		ret |= stdout_register_buf(&console_write_buf, &console_flush);
 		sysdbg3("Registering stdout\n");
 		ret |= stderr_register(&console_putc);
+		ret |= stderr_register_buf(&console_write_buf, &console_flush);
 		sysdbg3("Registering stderr\n");
 		ret |= stdin_register(&console_getc);
 		sysdbg3("Registering stdin\n");
@@ -106,6 +108,32 @@ status_t console_putc(const char c)
 	return ret;
 }
 
+/**
+ * console_write_buf - Send a block of data to console device
+ *
+ * @brief Block is passed to "write_buf" method of driver in one
+ * call, if driver does not have it, data is written char by char.
+ *
+ * @param[in] *buf: pointer to data
+ * @param[in] len: length of data
+ * @return status: function execution status
+ */
+status_t console_write_buf(const char *buf, size_t len)
+{
+	status_t ret = error_func_inval;
+	if(!console_attached)
+		return ret;
+	if(con->write_buf != NULL)
+		return con->write_buf(buf, len);
+	if(con->write != NULL)
+	{
+		ret = success;
+		while(len--)
+			ret |= con->write(*buf++);
+	}
+	return ret;
+}
+
 /**
  * console_getc - Fetch a char (8-bits) data form device driver
  *
@@ -161,6 +189,7 @@ status_t logger_attach_device(status_t dev_status, console_t *pcon)
 		ret = dev_status;
 		logger_attached = (ret == success) ? true : false;
 		ret |= stdlog_register(&logger_putc);
+		ret |= stdlog_register_buf(&logger_write_buf, NULL);
 	}
 	else
 		ret = error_device_inval;
@@ -185,6 +214,22 @@ status_t logger_putc(const char c)
 	return ret;
 }
 
+status_t logger_write_buf(const char *buf, size_t len)
+{
+	status_t ret = error_func_inval;
+	if(!logger_attached)
+		return ret;
+	if(log->write_buf != NULL)
+		return log->write_buf(buf, len);
+	if(log->write != NULL)
+	{
+		ret = success;
+		while(len--)
+			ret |= log->write(*buf++);
+	}
+	return ret;
+}
+
 status_t logger_dprint(const FILE *device)
 {
 	status_t lvar;
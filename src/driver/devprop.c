@@ -0,0 +1,178 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: devprop.c
+ * Description		: This file contains sources of driver side
+ *			  device/software property cache
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <status.h>
+#include <syslog.h>
+#include <arch.h>
+#include <lock/lock.h>
+#include <visor_call.h>
+#include <resource.h>
+#include <devprop.h>
+
+typedef struct devprop_entry
+{
+	vcall_id_t id;
+	call_arg_t key;
+	uintptr_t p;
+	size_t size;
+} devprop_entry_t;
+
+static devprop_entry_t devprop_cache[DEVPROP_CACHE_SIZE];
+static unsigned int devprop_victim;
+static lock_t devprop_key;
+
+static bool devprop_lookup(vcall_id_t id, call_arg_t key, vret_t *ret)
+{
+	bool hit = false;
+	lock_acquire(&devprop_key);
+	for(unsigned int i = 0; i < DEVPROP_CACHE_SIZE; i++)
+	{
+		if(devprop_cache[i].id == id && devprop_cache[i].key == key)
+		{
+			ret->p = devprop_cache[i].p;
+			ret->size = devprop_cache[i].size;
+			ret->status = success;
+			hit = true;
+			break;
+		}
+	}
+	lock_release(&devprop_key);
+	return hit;
+}
+
+static void devprop_insert(vcall_id_t id, call_arg_t key, const vret_t *ret)
+{
+	devprop_entry_t *e = NULL;
+	lock_acquire(&devprop_key);
+	/*
+	 * Other core might have resolved same property while
+	 * this one was in visor call, reuse its slot if so.
+	 * Else take a free slot or evict in round robin order.
+	 */
+	for(unsigned int i = 0; i < DEVPROP_CACHE_SIZE; i++)
+	{
+		if(devprop_cache[i].id == id && devprop_cache[i].key == key)
+		{
+			e = &devprop_cache[i];
+			break;
+		}
+		if(!e && !devprop_cache[i].id)
+			e = &devprop_cache[i];
+	}
+	if(!e)
+	{
+		e = &devprop_cache[devprop_victim];
+		devprop_victim = (devprop_victim + 1) % DEVPROP_CACHE_SIZE;
+	}
+	e->id = id;
+	e->key = key;
+	e->p = ret->p;
+	e->size = ret->size;
+	lock_release(&devprop_key);
+}
+
+static void devprop_fetch(vcall_id_t id, call_arg_t a0, call_arg_t a1, vret_t *ret)
+{
+	call_arg_t key = a0 | a1;
+
+	if(devprop_lookup(id, key, ret))
+		return;
+
+	arch_visor_call(id, a0, a1, 0, ret);
+	/* Only successful lookups are cached, failures are retried */
+	if(ret->status == success)
+		devprop_insert(id, key, ret);
+}
+
+/**
+ * devprop_fetch_sp - Cached fetch_sp
+ *
+ * @brief Resolves software properties of a device, visor call
+ * is issued only when the property is not cached already.
+ *
+ * @param[in] dev: software device ID
+ * @param[out] ret: result of fetch_sp
+ */
+void devprop_fetch_sp(sw_devid_t dev, vret_t *ret)
+{
+	devprop_fetch(fetch_sp, dev, 0, ret);
+}
+
+/**
+ * devprop_fetch_dp - Cached fetch_dp
+ *
+ * @brief Resolves device properties of a hardware module, visor
+ * call is issued only when the property is not cached already.
+ *
+ * @param[in] dev: hardware device class
+ * @param[in] index: instance of the device
+ * @param[out] ret: result of fetch_dp
+ */
+void devprop_fetch_dp(hw_devid_t dev, unsigned int index, vret_t *ret)
+{
+	devprop_fetch(fetch_dp, dev, index, ret);
+}
+
+/**
+ * devprop_fetch_pmux - Batched fetch_dp for pinmux
+ *
+ * @brief All pins of a pinmux belong to a single gpio port, so
+ * one lookup of the port properties serves every pin of the
+ * pinmux. Use this in place of fetch_dp per pin.
+ *
+ * @param[in] pmux: pinmux node from software properties
+ * @param[out] ret: gpio_module_t of the pinmux port
+ */
+void devprop_fetch_pmux(pinmux_t *pmux, vret_t *ret)
+{
+	if(!pmux)
+	{
+		ret->p = 0;
+		ret->size = 0;
+		ret->status = error_func_inval_arg;
+		return;
+	}
+	devprop_fetch(fetch_dp, gpio, pmux->port, ret);
+}
+
+/**
+ * devprop_invalidate - Drops a cached property
+ *
+ * @brief Needs to be called when a visor reconfigures the
+ * property of a device, so that the next fetch traps again.
+ *
+ * @param[in] id: fetch_sp or fetch_dp
+ * @param[in] key: device ID (class | index for fetch_dp)
+ */
+void devprop_invalidate(vcall_id_t id, call_arg_t key)
+{
+	lock_acquire(&devprop_key);
+	for(unsigned int i = 0; i < DEVPROP_CACHE_SIZE; i++)
+	{
+		if(devprop_cache[i].id == id && devprop_cache[i].key == key)
+			devprop_cache[i].id = 0;
+	}
+	lock_release(&devprop_key);
+}
+
+/**
+ * devprop_invalidate_all - Drops all cached properties
+ */
+void devprop_invalidate_all(void)
+{
+	lock_acquire(&devprop_key);
+	for(unsigned int i = 0; i < DEVPROP_CACHE_SIZE; i++)
+		devprop_cache[i].id = 0;
+	devprop_victim = 0;
+	lock_release(&devprop_key);
+}
@@ -9,8 +9,10 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <status.h>
 #include <syslog.h>
+#include <boottrace.h>
 #include <string.h>
 #include <arch.h>
 #include <driver.h>
@@ -20,74 +22,167 @@
  *
  * @brief This address of this variable will be same as start and end
  * of the driver allocation table. This gets updated via linker
- * script "driver.ld.sx"
+ * script "driver.ld.sx". Table is sorted on start order.
  */
 extern device_t _driver_table_start, _driver_table_end;
 
-static status_t driver_register_with_order(const device_t *start, const device_t *end, unsigned int order)
+/**
+ * _driver_exit_table_* - Pointer to driver exit table
+ *
+ * @brief Table of pointers to drivers sorted on exit order,
+ * populated by INCLUDE_DRIVER along with the driver table.
+ */
+extern const device_t * const _driver_exit_table_start[];
+extern const device_t * const _driver_exit_table_end[];
+
+/*
+ * Name index over driver table, built on first lookup. Each slot
+ * holds table position + 1 of the driver, 0 marks empty slot.
+ */
+static uint8_t driver_index[DRIVER_INDEX_SIZE];
+static bool driver_index_valid, driver_index_built;
+static lock_t driver_index_key;
+
+static unsigned int driver_name_hash(const char *name)
 {
-	status_t ret = success;
-	device_t *ptr = (device_t *)start;
+	unsigned int h = 5381;
+	while(*name)
+		h = (h << 5) + h + (unsigned char)*name++;
+	return h;
+}
+
+static void driver_index_build(void)
+{
+	device_t *ptr;
+	unsigned int h, pos = 0;
+	size_t n = (size_t)(&_driver_table_end - &_driver_table_start);
+
+	lock_acquire(&driver_index_key);
+	if(driver_index_built)
+		goto exit;
+
 	/*
-	 * Iterate the whole driver table so that on order
-	 * match execute driver_setup
+	 * Keep at least one slot empty so that probing of names
+	 * not in the table terminates. If table does not fit,
+	 * driver_find falls back to linear scan over hashes.
 	 */
-	while(ptr < end)
+	driver_index_valid = (n < DRIVER_INDEX_SIZE) && (n < UINT8_MAX);
+	for(ptr = &_driver_table_start; ptr < &_driver_table_end; ptr++, pos++)
 	{
-		if(order == ptr->sorder)
-			ret |= driver_register(ptr);
-		ptr++;
+		h = driver_name_hash(ptr->name);
+		ptr->hash = (uint16_t)h;
+		if(!driver_index_valid)
+			continue;
+		h &= (DRIVER_INDEX_SIZE - 1);
+		while(driver_index[h])
+			h = (h + 1) & (DRIVER_INDEX_SIZE - 1);
+		driver_index[h] = (uint8_t)(pos + 1);
 	}
-	return ret;
+	arch_dmb();
+	driver_index_built = true;
+exit:
+	lock_release(&driver_index_key);
 }
 
-static status_t driver_deregister_with_order(const device_t *start, const device_t *end, unsigned int order)
+/**
+ * driver_find - API call to find driver in the driver table
+ *
+ * @brief Looks up the name index, so only the drivers which
+ * collide on hash are compared. If there are multiple drivers
+ * with same name, the one first in the table is returned.
+ *
+ * @param[in] *name: Name of the driver
+ * @return dev: Pointer to the driver, NULL if not found
+ */
+device_t *driver_find(const char *name)
 {
-	status_t ret = success;
-	device_t *ptr = (device_t *)start;
-	/*
-	 * Iterate the whole driver table so that on order
-	 * match execute driver_exit
-	 */
-	while(ptr < end)
+	device_t *dev;
+	unsigned int h, i;
+	uint16_t h16;
+
+	if(!driver_index_built)
+		driver_index_build();
+
+	h = driver_name_hash(name);
+	h16 = (uint16_t)h;
+	if(driver_index_valid)
 	{
-		if(order == ptr->sorder)
-			ret |= driver_deregister(ptr);
-		ptr++;
+		for(i = h & (DRIVER_INDEX_SIZE - 1); driver_index[i];
+				i = (i + 1) & (DRIVER_INDEX_SIZE - 1))
+		{
+			dev = &_driver_table_start + (driver_index[i] - 1);
+			if(dev->hash == h16 && strcmp(dev->name, name) == 0)
+				return dev;
+		}
+		return NULL;
 	}
-	return ret;
+
+	for(dev = &_driver_table_start; dev < &_driver_table_end; dev++)
+	{
+		if(dev->hash == h16 && strcmp(dev->name, name) == 0)
+			return dev;
+	}
+	return NULL;
 }
 
-static status_t driver_setup_with_name(const device_t *start, const device_t *end, const char *name)
+/**
+ * driver_deps_ready - Checks if dependencies of driver are met
+ *
+ * @brief Dependencies which are not built into the image are
+ * treated as met, so that optional drivers can be listed.
+ *
+ * @param[in] *dev: Device driver pointer
+ * @return bool: true if all the dependencies are ready
+ */
+static bool driver_deps_ready(const device_t *dev)
 {
-	device_t *ptr = (device_t *)start;
-	/*
-	 * Iterate over the driver table and compare the names.
-	 * On successful compare, run driver_setup.
-	 */
-	while(ptr < end)
+	const device_t *dep;
+	for(uint8_t i = 0; i < dev->n_deps; i++)
 	{
-		if(strcmp(ptr->name, name) == 0)
-			return driver_register(ptr);
-		ptr++;
+		dep = driver_find(dev->deps[i]);
+		if(dep && !dep->ready)
+			return false;
 	}
-	return error_func_inval;
+	return true;
 }
 
-static status_t driver_exit_with_name(const device_t *start, const device_t *end, const char *name)
+/**
+ * driver_probe_deferred - Retries the deferred drivers
+ *
+ * @brief Starting a driver can satisfy dependencies of other
+ * deferred drivers, hence the table is retried until a pass
+ * makes no progress.
+ *
+ * @return status: execution status of retried drivers in "or"
+ *           method, error_driver_defer if any is still waiting
+ */
+static status_t driver_probe_deferred()
 {
-	device_t *ptr = (device_t *)start;
-	/*
-	 * Iterate over the driver table and compare the names.
-	 * On successful compare, run driver_setup.
-	 */
-	while(ptr < end)
+	status_t ret = success, status;
+	device_t *ptr;
+	bool progress, waiting;
+
+	do
 	{
-		if(strcmp(ptr->name, name) == 0)
-			return driver_deregister(ptr);
-		ptr++;
-	}
-	return error_func_inval;
+		progress = false;
+		waiting = false;
+		for(ptr = &_driver_table_start; ptr < &_driver_table_end; ptr++)
+		{
+			if(!ptr->defer)
+				continue;
+			status = driver_register(ptr);
+			if(status == error_driver_defer)
+			{
+				waiting = true;
+				continue;
+			}
+			progress = true;
+			if(status != error_driver_init_done)
+				ret |= status;
+		}
+	} while(progress && waiting);
+
+	return waiting ? (ret | error_driver_defer) : ret;
 }
 
 /**
@@ -97,19 +192,63 @@ static status_t driver_exit_with_name(const device_t *start, const device_t *end
  * @brief This function parses all the drivers in the table and runs
  * setup call of each driver. The driver_setup is called based
  * on the start order or rank. 0 to be started first and 255 at
- * last.
+ * last. Drivers whose dependencies are not ready are deferred
+ * and async drivers are started after the ordered ones, unless
+ * other core has already picked them via driver_setup_async.
  *
  * @return status: returns the execution status of all drivers_setup
  *           in "or" method
  */
 status_t driver_setup_all()
 {
-	status_t ret = success;
-	unsigned int order;
-	/* This loop controls the start order */
-	for(order = 0; order < 256; order++)
-		ret |= driver_register_with_order(&_driver_table_start,
-				&_driver_table_end, order);
+	status_t ret = success, status;
+	device_t *ptr = &_driver_table_start;
+	/*
+	 * Linker has sorted the table on start order,
+	 * so one pass runs the drivers in order
+	 */
+	while(ptr < &_driver_table_end)
+	{
+		if(!ptr->async)
+		{
+			status = driver_register(ptr);
+			if(status != error_driver_defer)
+				ret |= status;
+		}
+		ptr++;
+	}
+	ret |= driver_setup_async();
+	return ret;
+}
+
+/**
+ * driver_setup_async - API call to start async drivers
+ *
+ * @brief This function starts async drivers which are not yet
+ * claimed and retries deferred drivers. It can be called from
+ * secondary cores (plug_secondary) or from a task while boot core
+ * runs driver_setup_all, each driver gets started only once.
+ *
+ * @return status: returns the execution status of drivers_setup
+ *           in "or" method
+ */
+status_t driver_setup_async()
+{
+	status_t ret = success, status;
+	device_t *ptr = &_driver_table_start;
+
+	while(ptr < &_driver_table_end)
+	{
+		if(ptr->async && (ptr->percpu || !ptr->exec))
+		{
+			status = driver_register(ptr);
+			if(status != error_driver_defer &&
+				status != error_driver_init_done)
+				ret |= status;
+		}
+		ptr++;
+	}
+	ret |= driver_probe_deferred();
 	return ret;
 }
 
@@ -128,11 +267,16 @@ status_t driver_setup_all()
 status_t driver_exit_all()
 {
 	status_t ret = success;
-	int order;
-	/* This loop controls the exit order */
-	for(order = 255; order >= 0; order--)
-		ret |= driver_deregister_with_order(&_driver_table_start,
-				&_driver_table_end, order);
+	const device_t * const *ptr = _driver_exit_table_end;
+	/*
+	 * Exit table is sorted on ascending exit order,
+	 * walk it backwards to exit 255 first
+	 */
+	while(ptr > _driver_exit_table_start)
+	{
+		ptr--;
+		ret |= driver_deregister((device_t *)*ptr);
+	}
 	return ret;
 }
 
@@ -148,8 +292,8 @@ status_t driver_exit_all()
  */
 status_t driver_setup(const char *name)
 {
-	return driver_setup_with_name(&_driver_table_start,
-			&_driver_table_end, name);
+	device_t *dev = driver_find(name);
+	return dev ? driver_register(dev) : error_func_inval;
 }
 
 /**
@@ -164,15 +308,17 @@ status_t driver_setup(const char *name)
  */
 status_t driver_exit(const char *name)
 {
-	return driver_exit_with_name(&_driver_table_start,
-			&_driver_table_end, name);
+	device_t *dev = driver_find(name);
+	return dev ? driver_deregister(dev) : error_func_inval;
 }
 
 /**
  * driver_register - API call register driver for a device
  *
  * @brief This function is responsible to invoke driver_setup api
- * of corresponding device driver.
+ * of corresponding device driver. If dependencies are not ready
+ * or driver_setup returns error_driver_defer, the driver is marked
+ * deferred and gets retried by driver_setup_all/async.
  *
  * @param[in] *dev: Device driver pointer
  * @return status: function exexcution status
@@ -184,8 +330,11 @@ status_t driver_register(device_t *dev _UNUSED)
 
 	if(!dev->percpu)
 	{
+		/* Claim the driver, so that only one core starts it */
 		lock_acquire(&dev->key);
 		flag = dev->exec;
+		dev->exec = 1;
+		arch_dmb();
 		lock_release(&dev->key);
 
 		if(flag)
@@ -193,15 +342,37 @@ status_t driver_register(device_t *dev _UNUSED)
 			ret = error_driver_init_done;
 			goto exit;
 		}
+	}
 
-		lock_acquire(&dev->key);
-		dev->exec = 1;
-		arch_dmb();
-		lock_release(&dev->key);
+	if(driver_deps_ready(dev))
+		ret = dev->driver_setup();
+	else
+	{
+		sysdbg("%s is waiting on dependencies\n", dev->name);
+		ret = error_driver_defer;
 	}
 
-	ret = dev->driver_setup();
-	(ret == success) ? syslog(pass, "Started %s\n", dev->name) :
+	lock_acquire(&dev->key);
+	if(ret == error_driver_defer)
+	{
+		dev->exec = 0;
+		dev->defer = 1;
+	}
+	else
+	{
+		dev->defer = 0;
+		dev->ready = (ret == success);
+	}
+	arch_dmb();
+	lock_release(&dev->key);
+
+	boottrace_mark(dev->name);
+
+	if(ret == success)
+		syslog(pass, "Started %s\n", dev->name);
+	else if(ret == error_driver_defer)
+		syslog(info, "Deferred %s\n", dev->name);
+	else
 		syslog(fail, "Couldn't start %s (Err: %p)\n", dev->name, ret);
 exit:
 	return ret;
@@ -211,7 +382,8 @@ exit:
  * driver_deregister - API call deregister driver for a device
  *
  * @brief This function is responsible to invoke driver_exit api
- * of corresponding device driver.
+ * of corresponding device driver. Suspended driver is resumed
+ * before its exit is called.
  *
  * @param[in] *dev: Device driver pointer
  * @return status: function exexcution status
@@ -219,24 +391,31 @@ exit:
 status_t driver_deregister(device_t *dev _UNUSED)
 {
 	status_t ret;
-	uint8_t flag;
+	uint8_t flag = 1;
 
+	lock_acquire(&dev->key);
+	dev->defer = 0;
 	if(!dev->percpu)
 	{
-		lock_acquire(&dev->key);
 		flag = dev->exec;
-		lock_release(&dev->key);
-
-		if(!flag)
-		{
-			ret = error_driver;
-			goto exit;
-		}
-
-		lock_acquire(&dev->key);
 		dev->exec = 0;
-		arch_dmb();
-		lock_release(&dev->key);
+	}
+	if(flag)
+		dev->ready = 0;
+	/* driver_exit expects a running device */
+	if(dev->suspended)
+	{
+		dev->driver_resume();
+		dev->suspended = 0;
+		dev->pm_sys = 0;
+	}
+	arch_dmb();
+	lock_release(&dev->key);
+
+	if(!flag)
+	{
+		ret = error_driver;
+		goto exit;
 	}
 
 	syslog(pass, "Stopping %s\n", dev->name);
@@ -244,3 +423,159 @@ status_t driver_deregister(device_t *dev _UNUSED)
 exit:
 	return ret;
 }
+
+/**
+ * driver_pm_suspend - Suspends a running driver
+ *
+ * @param[in] *dev: Device driver pointer
+ * @param[in] sys: true if called from system wide suspend
+ * @return status: success if driver is (already) suspended,
+ *           else error returned by driver_suspend (veto)
+ */
+static status_t driver_pm_suspend(device_t *dev, bool sys)
+{
+	status_t ret = success;
+
+	if(!dev->driver_suspend || !dev->driver_resume || dev->percpu)
+		return error_func_inval;
+
+	lock_acquire(&dev->key);
+	if(!dev->ready)
+		ret = error_driver;
+	else if(!dev->suspended)
+	{
+		ret = dev->driver_suspend();
+		if(ret == success)
+		{
+			dev->suspended = 1;
+			dev->pm_sys = sys;
+		}
+	}
+	else if(!sys)
+		dev->pm_sys = 0;
+	arch_dmb();
+	lock_release(&dev->key);
+	return ret;
+}
+
+/**
+ * driver_pm_resume - Resumes a suspended driver
+ *
+ * @brief System wide resume only wakes the drivers which were
+ * suspended by system wide suspend, drivers suspended by name
+ * stay suspended till they are resumed by name.
+ *
+ * @param[in] *dev: Device driver pointer
+ * @param[in] sys: true if called from system wide resume
+ * @return status: execution status of driver_resume
+ */
+static status_t driver_pm_resume(device_t *dev, bool sys)
+{
+	status_t ret = success;
+
+	if(!dev->driver_suspend || !dev->driver_resume || dev->percpu)
+		return error_func_inval;
+
+	lock_acquire(&dev->key);
+	if(dev->suspended && (!sys || dev->pm_sys))
+	{
+		ret = dev->driver_resume();
+		if(ret == success)
+		{
+			dev->suspended = 0;
+			dev->pm_sys = 0;
+		}
+	}
+	arch_dmb();
+	lock_release(&dev->key);
+	return ret;
+}
+
+/**
+ * driver_suspend_all - API call to suspend all the drivers which
+ * support runtime power management
+ *
+ * @brief Drivers are suspended in the exit order, 255 first. If a
+ * driver vetoes, drivers suspended so far are resumed and the veto
+ * is returned, so the system is either fully suspended or running.
+ * This is meant for idle/sleep hooks and clock reconfiguration,
+ * where a full driver_exit_all/driver_setup_all is too costly.
+ * Console may be suspended, so this does not print.
+ *
+ * @return status: success or status of the vetoing driver
+ */
+status_t driver_suspend_all()
+{
+	status_t ret = success;
+	device_t *dev;
+	const device_t * const *ptr = _driver_exit_table_end;
+
+	while(ptr > _driver_exit_table_start)
+	{
+		ptr--;
+		dev = (device_t *)*ptr;
+		if(!dev->driver_suspend || dev->percpu ||
+			!dev->ready || dev->suspended)
+			continue;
+		ret = driver_pm_suspend(dev, true);
+		if(ret != success)
+			goto rollback;
+	}
+	return success;
+rollback:
+	while(++ptr < _driver_exit_table_end)
+		driver_pm_resume((device_t *)*ptr, true);
+	return ret;
+}
+
+/**
+ * driver_resume_all - API call to resume drivers suspended by
+ * driver_suspend_all
+ *
+ * @brief Drivers are resumed in reverse of the suspend order.
+ *
+ * @return status: returns the execution status of all driver_resume
+ *           in "or" method
+ */
+status_t driver_resume_all()
+{
+	status_t ret = success;
+	device_t *dev;
+	const device_t * const *ptr = _driver_exit_table_start;
+
+	while(ptr < _driver_exit_table_end)
+	{
+		dev = (device_t *)*ptr;
+		if(dev->pm_sys)
+			ret |= driver_pm_resume(dev, true);
+		ptr++;
+	}
+	return ret;
+}
+
+/**
+ * driver_suspend - API call to suspend driver using name
+ *
+ * @brief Driver suspended by name is not resumed by
+ * driver_resume_all, it needs driver_resume.
+ *
+ * @param[in] *name: Take name of driver (string) as argument
+ * @return status: return the execution status of driver_suspend
+ */
+status_t driver_suspend(const char *name)
+{
+	device_t *dev = driver_find(name);
+	return dev ? driver_pm_suspend(dev, false) : error_func_inval;
+}
+
+/**
+ * driver_resume - API call to resume driver using name
+ *
+ * @param[in] *name: Take name of driver (string) as argument
+ * @return status: return the execution status of driver_resume
+ */
+status_t driver_resume(const char *name)
+{
+	device_t *dev = driver_find(name);
+	return dev ? driver_pm_resume(dev, false) : error_func_inval;
+}
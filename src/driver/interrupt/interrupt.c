@@ -67,22 +67,86 @@ status_t unlink_interrupt(int_module_t target, unsigned int id)
 	return ret;
 }
 
-status_t wait_lock(int_wait_t *var)
+static const completion_ops_t *completion_ops;
+
+/**
+ * completion_register_ops - Registers blocking ops of OS
+ *
+ * @brief Called by OS once it can block tasks. Till then, or with
+ * NULL ops, waiters sleep in wfi.
+ *
+ * @param[in] ops: block/wake ops
+ */
+status_t completion_register_ops(const completion_ops_t *ops)
 {
-	var->lock = 1;
+	if(ops && (!ops->block || !ops->wake))
+		return error_func_inval_arg;
+	completion_ops = ops;
+	arch_dmb();
 	return success;
 }
 
-status_t wait_till_irq(int_wait_t *var)
+/**
+ * completion_init - Clears any signal not yet consumed
+ *
+ * @brief Needs to be called before starting the operation whose
+ * completion is to be waited on, if a stale signal is not wanted.
+ *
+ * @param[in] c: completion
+ */
+void completion_init(completion_t *c)
+{
+	istate_t ist;
+	arch_di_save_state(&ist);
+	c->done = 0;
+	arch_ei_restore_state(&ist);
+}
+
+/**
+ * completion_wait - Waits till completion is signalled
+ *
+ * @brief Consumes the signal, returns immediately if it was signalled
+ * before the call. Only the calling task is blocked when OS is running,
+ * bare metal callers and callers which can not block (ISR, idle) sleep
+ * in wfi and wake on every irq to recheck.
+ *
+ * @param[in] c: completion
+ */
+status_t completion_wait(completion_t *c)
 {
-	do
+	istate_t ist;
+	const completion_ops_t *ops;
+
+	arch_di_save_state(&ist);
+	c->waiting++;
+	while(!c->done)
+	{
+		ops = completion_ops;
+		if(ops && ops->block(&c->wait_q) == success)
+			continue;
+		arch_ei_restore_state(&ist);
 		arch_wfi();
-	while(var->lock == 1);
+		arch_di_save_state(&ist);
+	}
+	c->done = 0;
+	c->waiting--;
+	arch_ei_restore_state(&ist);
 	return success;
 }
 
-status_t wait_release_on_irq(int_wait_t *var)
+/**
+ * completion_signal - Signals completion, can be called from ISR
+ *
+ * @param[in] c: completion
+ */
+void completion_signal(completion_t *c)
 {
-	var->lock = 0;
-	return success;
+	istate_t ist;
+	const completion_ops_t *ops = completion_ops;
+
+	arch_di_save_state(&ist);
+	c->done = 1;
+	if(ops && c->wait_q)
+		ops->wake(&c->wait_q);
+	arch_ei_restore_state(&ist);
 }
@@ -20,24 +20,39 @@
 #include <driver/interrupt_controller.h>
 #include <platform.h>
 
-static ic_t *ic;
-static bool ic_attached = false;
+/*
+ * Attached controller is published through a single pointer, NULL
+ * when no controller is attached. Writers (attach/release and the
+ * configuration calls) serialise on ic_lock, while the dispatch and
+ * enable/disable paths only load the pointer once and never lock.
+ * Pointer is stored after the ic_t is filled up, with a barrier in
+ * between, so readers see either NULL or a complete ic_t.
+ * Release only unpublishes the pointer, a reader that loaded it
+ * before can still call through it. So irqs of the controller must
+ * be quiesced on all harts before release and its ic_t can be freed
+ * only after release returns.
+ */
+static ic_t * volatile ic;
 static lock_t ic_lock;
 
 status_t ic_attach_device(status_t dev_status, ic_t *pic)
 {
 	status_t ret;
 	lock_acquire(&ic_lock);
-	ic_attached = false;
-	ic = pic;
+	ic = NULL;
 
-	if(ic != NULL)
+	if(pic != NULL)
 	{
 		ret = dev_status;
-		ic_attached = (ret == success) ? true : false;
+		if(ret == success)
+		{
+			arch_dmb();
+			ic = pic;
+		}
 	}
 	else
 		ret = error_device_inval;
+	arch_dmb();
 	lock_release(&ic_lock);
 	return ret;
 }
@@ -46,7 +61,7 @@ status_t ic_release_device()
 {
 	lock_acquire(&ic_lock);
 	ic = NULL;
-	ic_attached = false;
+	arch_dmb();
 	lock_release(&ic_lock);
 	return success;
 }
@@ -56,82 +71,75 @@ unsigned int ic_get_irq()
 	/* 0 is invalid irq id as 0 is usually
 	 * associated to reset
 	 */
-	unsigned int ret = 0;
-	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->get_irq();
-	lock_release(&ic_lock);
-	return ret;
+	ic_t *pic = ic;
+	return pic ? pic->get_irq() : 0;
 }
 
 status_t ic_set_priority_of_irq(unsigned int irq_id, unsigned int priority)
 {
 	status_t ret = error_driver_init_failed;
+	ic_t *pic;
 	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->set_priority(irq_id, priority);
+	pic = ic;
+	if(pic)
+		ret = pic->set_priority(irq_id, priority);
 	lock_release(&ic_lock);
 	return ret;
 }
 
 unsigned int ic_get_priority_of_irq(unsigned int irq_id)
 {
-	unsigned int ret = 0;
-	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->get_priority(irq_id);
-	lock_release(&ic_lock);
-	return ret;
+	ic_t *pic = ic;
+	return pic ? pic->get_priority(irq_id) : 0;
 }
 
+/*
+ * Enable/disable touch only the enable bits of calling core,
+ * controller driver keeps the update atomic w.r.t local irqs.
+ */
 status_t ic_en_irq(unsigned int irq_id)
 {
-	status_t ret = error_driver_init_failed;
-	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->en_irq(irq_id);
-	lock_release(&ic_lock);
-	return ret;
+	ic_t *pic = ic;
+	return pic ? pic->en_irq(irq_id) : error_driver_init_failed;
 }
 
 status_t ic_dis_irq(unsigned int irq_id)
 {
-	status_t ret = error_driver_init_failed;
-	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->dis_irq(irq_id);
-	lock_release(&ic_lock);
-	return ret;
+	ic_t *pic = ic;
+	return pic ? pic->dis_irq(irq_id) : error_driver_init_failed;
 }
 
 unsigned int ic_get_affinity_of_core()
 {
-	unsigned int ret = 0;
-	unsigned int core_id = arch_core_index();
-	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->get_affinity(core_id);
-	lock_release(&ic_lock);
-	return ret;
+	ic_t *pic = ic;
+	return pic ? pic->get_affinity(arch_core_index()) : 0;
 }
 
 status_t ic_set_affinity_of_core(unsigned int irq_id)
 {
 	status_t ret = error_driver_init_failed;
 	unsigned int core_id = arch_core_index();
+	ic_t *pic;
 	sysdbg3("Affining IRQ#%u to Core-%u\n", irq_id, core_id);
 	lock_acquire(&ic_lock);
-	if(ic_attached)
-		ret = ic->set_affinity(core_id, irq_id);
+	pic = ic;
+	if(pic)
+		ret = pic->set_affinity(core_id, irq_id);
 	lock_release(&ic_lock);
 	return ret;
 }
 
+/*
+ * Handlers are registered in the table of calling core, which
+ * is the core that enables and services the irq.
+ */
 void ic_register_interrupt_handler(unsigned int id, void (* handler)(void))
 {
+	ic_t *pic;
 	lock_acquire(&ic_lock);
 	sysdbg3("Registering IRQ#%u\n", id);
-	if(ic_attached && (handler != NULL) && id)
-		ic->register_handler(id, handler);
+	pic = ic;
+	if(pic && (handler != NULL) && id)
+		pic->register_handler(id, handler);
 	lock_release(&ic_lock);
 }
@@ -13,6 +13,9 @@ PLIC_PATH	:= $(GET_PATH)
 ifeq ($(ARCH), riscv)
 ifneq ($(N_PLAT_IRQS),0)
 
+PLIC_NESTED	?= 0
+$(eval $(call add_define,PLIC_NESTED))
+
 DIR		:= $(PLIC_PATH)
 include mk/obj.mk
 
@@ -16,12 +16,15 @@
 #include <assert.h>
 #include <arch.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <interrupt.h>
 #include <resource.h>
 #include <driver.h>
 #include <mmio.h>
 #include <platform.h>
 #include <driver/interrupt_controller.h>
+#include <mempool.h>
+#include <irqstat.h>
 
 #ifndef PLIC_VERSION
 #define PLIC_VERSION	0x0100		// 01.00
@@ -29,6 +32,9 @@
 
 #include "plic_private.h"
 
+INCLUDE_MEMPOOL(plic_port_pool, plic_port_t, 1);
+INCLUDE_MEMPOOL(plic_ic_pool, ic_t, 1);
+
 static plic_port_t *port;
 
 static status_t plic_setup()
@@ -36,12 +42,12 @@ static status_t plic_setup()
 	vret_t vres;
 	const module_t *dp;
 
-	arch_visor_call(fetch_dp, plic, 0, 0, &vres);
+	devprop_fetch_dp(plic, 0, &vres);
 
 	if(vres.status != success)
 		return vres.status;
 	dp = (module_t *)vres.p;
-	port = (plic_port_t *)malloc(sizeof(plic_port_t));
+	port = (plic_port_t *)mempool_alloc(&plic_port_pool);
 	if(!port)
 		return error_memory_low;
 	port->baddr = dp->baddr;
@@ -80,17 +86,25 @@ static status_t plic_set_threshold(uint32_t core_id, uint32_t threshold)
 	return success;
 }
 
-static uint32_t plic_get_interrupt()
+static inline uint32_t plic_claim(uint32_t core_id)
 {
-	unsigned int irq;
-	uint32_t core_id;
-	assert(port->baddr);
-	core_id = arch_core_index();
-	irq = MMIO32(port->baddr + PLIC_ICLAIM_OFFSET(core_id));
+	uint32_t irq = MMIO32(port->baddr + PLIC_ICLAIM_OFFSET(core_id));
 	arch_dmb();
 	return irq;
 }
 
+static inline void plic_complete(uint32_t core_id, uint32_t irq_id)
+{
+	MMIO32(port->baddr + PLIC_ICLAIM_OFFSET(core_id)) = irq_id;
+	arch_dmb();
+}
+
+static uint32_t plic_get_interrupt()
+{
+	assert(port->baddr);
+	return plic_claim(arch_core_index());
+}
+
 
 static void plic_clr_interrupt(uint32_t irq_id)
 {
@@ -98,42 +112,95 @@ static void plic_clr_interrupt(uint32_t irq_id)
 	assert(port->baddr);
 	core_id = arch_core_index();
 	sysdbg3("Clearing IRQ#%u on Core-%u\n", irq_id, core_id);
-	MMIO32(port->baddr + PLIC_ICLAIM_OFFSET(core_id)) = irq_id;
-	arch_dmb();
+	plic_complete(core_id, irq_id);
 	return;
 }
 
+/*
+ * Enable registers are per hart, masking local interrupts is
+ * enough to keep read-modify-write atomic, no lock is needed.
+ */
 static status_t plic_int_en(uint32_t irq_id)
 {
+	istate_t ist;
 	uint32_t core_id, irq_shift;
 	assert(port->baddr);
 	core_id = arch_core_index();
 	sysdbg3("Enabling IRQ#%u on Core-%u\n", irq_id, core_id);
 	irq_shift = irq_id % 32;
+	arch_di_save_state(&ist);
 	MMIO32(port->baddr + PLIC_IENABLE_OFFSET(core_id, irq_id)) |= (1 << irq_shift);
 	arch_dmb();
+	arch_ei_restore_state(&ist);
 	return success;
 }
 
 static status_t plic_int_dis(uint32_t irq_id)
 {
+	istate_t ist;
 	uint32_t core_id, irq_shift;
 	assert(port->baddr);
 	core_id = arch_core_index();
 	sysdbg3("Disabling IRQ#%u on Core-%u\n", irq_id, core_id);
 	irq_shift = irq_id % 32;
+	arch_di_save_state(&ist);
 	MMIO32(port->baddr + PLIC_IENABLE_OFFSET(core_id, irq_id)) &= ~(1 << irq_shift);
 	arch_dmb();
+	arch_ei_restore_state(&ist);
 	return success;
 }
 
+/*
+ * Sources are claimed until PLIC returns 0, so that all the
+ * pending sources are serviced in one trap entry. Completion
+ * is signalled after the handler has serviced the source, else
+ * a level source still asserted would be claimed again.
+ */
+#if PLIC_NESTED
+/*
+ * Nested mode: threshold of the hart is raised to the priority of
+ * the claimed source and interrupts are re-enabled while its handler
+ * runs, so only sources of strictly higher priority can preempt it.
+ * Handlers then need to be reentrant safe w.r.t lower priority ones.
+ */
+static void plic_irqhandler()
+{
+	istate_t ist;
+	unsigned long t_start;
+	uint32_t irq, core_id, threshold;
+	assert(port->baddr);
+	core_id = arch_core_index();
+	threshold = plic_get_threshold(core_id);
+	while((irq = plic_claim(core_id)) != 0)
+	{
+		sysdbg3("Handling IRQ#%u\n", irq);
+		plic_set_threshold(core_id, plic_get_priority(irq));
+		arch_ei();
+		t_start = irqstat_stamp();
+		plic_irq_handler[core_id][irq]();
+		irqstat_record(int_plat, irq, irqstat_trap_stamp(), t_start, irqstat_stamp());
+		arch_di_save_state(&ist);
+		plic_complete(core_id, irq);
+		plic_set_threshold(core_id, threshold);
+	}
+}
+#else
 static void plic_irqhandler()
 {
-	uint32_t irq = plic_get_interrupt();
-	plic_clr_interrupt(irq);
-	sysdbg3("Handling IRQ#%u\n", irq);
-	plic_irq_handler[irq]();
+	unsigned long t_start;
+	uint32_t irq, core_id;
+	assert(port->baddr);
+	core_id = arch_core_index();
+	while((irq = plic_claim(core_id)) != 0)
+	{
+		sysdbg3("Handling IRQ#%u\n", irq);
+		t_start = irqstat_stamp();
+		plic_irq_handler[core_id][irq]();
+		irqstat_record(int_plat, irq, irqstat_trap_stamp(), t_start, irqstat_stamp());
+		plic_complete(core_id, irq);
+	}
 }
+#endif
 
 static bool plic_get_pending(uint32_t irq_id)
 {
@@ -146,7 +213,7 @@ static bool plic_get_pending(uint32_t irq_id)
 static void plic_register_irq_handler(uint32_t id, void (* handler)(void))
 {
 	RET_ON_FAIL(id && handler,);
-	plic_irq_handler[id] = handler;
+	plic_irq_handler[arch_core_index()][id] = handler;
 	arch_dsb();
 }
 
@@ -154,9 +221,13 @@ static ic_t *plic_port;
 
 static status_t plic_driver_exit()
 {
-	free(plic_port);
-	free(port);
-	return ic_release_device();
+	/* Unpublish first so that no reader picks up ic_t being freed */
+	status_t ret = ic_release_device();
+	mempool_free(&plic_ic_pool, plic_port);
+	mempool_free(&plic_port_pool, port);
+	plic_port = NULL;
+	port = NULL;
+	return ret;
 }
 
 static status_t plic_driver_exit_pcpu()
@@ -172,7 +243,7 @@ static status_t plic_driver_setup()
 	ret = plic_setup();
 	if(ret)
 		goto cleanup_exit;
-	plic_port = (ic_t *)malloc(sizeof(ic_t));
+	plic_port = (ic_t *)mempool_alloc(&plic_ic_pool);
 	if(!plic_port)
 	{
 		ret = error_memory_low;
@@ -228,4 +299,4 @@ exit:
 }
 
 INCLUDE_DRIVER(riscv_plic, plic_driver_setup, plic_driver_exit, 0, 0, 0);
-INCLUDE_DRIVER(riscv_plic_pcpu, plic_driver_setup_pcpu, plic_driver_exit_pcpu, 1, 1, 1);
+INCLUDE_DRIVER_DEPS(riscv_plic_pcpu, plic_driver_setup_pcpu, plic_driver_exit_pcpu, 1, 1, 1, 0, "riscv_plic");
@@ -27,4 +27,6 @@ typedef struct plic_port
 	const irqs_t *irq;
 } plic_port_t;
 
-static void (* plic_irq_handler[N_PLAT_IRQS])(void) = {[0 ... N_PLAT_IRQS-1] = &plat_panic_handler};
+/* Handler table per hart, each hart services the irqs it has enabled */
+static void (* plic_irq_handler[N_CORES][N_PLAT_IRQS])(void) =
+	{[0 ... N_CORES-1] = {[0 ... N_PLAT_IRQS-1] = &plat_panic_handler}};
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <lock/lock.h>
 #include <driver.h>
 #include <driver/onboardled.h>
@@ -110,7 +111,7 @@ static status_t onboardled_setup(void)
 	status_t ret;
 
 	lock_acquire(&obledlock);
-	arch_visor_call(fetch_sp, onboard_led, 0, 0, &vres);
+	devprop_fetch_sp(onboard_led, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("%p - sp node could not be found!\n", onboard_led);
@@ -129,12 +130,11 @@ static status_t onboardled_setup(void)
 		goto exit;
 	}
 
+	ret = gpio_pmux_alloc(obledPort, obled_sp->pmux);
+	if(ret != success)
+		goto exit;
 	for(uint8_t i = 0; i < obled_sp->pmux->npins; i++)
-	{
-		ret |= gpio_pin_alloc(&obledPort[i], obled_sp->pmux->port,
-				obled_sp->pmux->pins[i]);
 		ret |= gpio_pin_mode(&obledPort[i], out);
-	}
 exit:
 	lock_release(&obledlock);
 	return ret;
@@ -167,4 +167,4 @@ exit:
 	return ret;
 }
 
-INCLUDE_DRIVER(OBrdLED, onboardled_setup, onboardled_exit, 0, 255, 255);
\ No newline at end of file
+INCLUDE_DRIVER_ASYNC(OBrdLED, onboardled_setup, onboardled_exit, 0, 255, 255);
\ No newline at end of file
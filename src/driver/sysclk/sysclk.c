@@ -101,11 +101,11 @@ status_t sysclk_execute_pre_config_clk_callback(void)
 {
 	status_t ret = success;
 	sysclk_config_clk_callback_t *temp;
-	temp = root;
 
 	lock_acquire(&sysclk_cb_key);
+	temp = root;
 
-	do
+	while(temp)
 	{
 		if(temp->pre_config)
 			ret |= temp->pre_config();
@@ -115,7 +115,7 @@ status_t sysclk_execute_pre_config_clk_callback(void)
 			ret |= error_func_inval;
 		}
 		temp = temp->next;
-	} while(temp);
+	}
 
 	lock_release(&sysclk_cb_key);
 	return ret;
@@ -125,13 +125,12 @@ status_t sysclk_execute_post_config_clk_callback(void)
 {
 	status_t ret = success;
 	sysclk_config_clk_callback_t *temp;
-	temp = root;
 
 	lock_acquire(&sysclk_cb_key);
+	temp = root;
 
-	do
+	while(temp)
 	{
-		ret |= temp->post_config();
 		if(temp->post_config)
 			ret |= temp->post_config();
 		else
@@ -140,7 +139,7 @@ status_t sysclk_execute_post_config_clk_callback(void)
 			ret |= error_func_inval;
 		}
 		temp = temp->next;
-	} while(temp);
+	}
 
 	lock_release(&sysclk_cb_key);
 	return ret;
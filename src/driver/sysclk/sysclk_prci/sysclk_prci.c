@@ -17,6 +17,7 @@
 #include <assert.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <driver.h>
 #include <arch.h>
 #include <platform.h>
@@ -42,7 +43,7 @@ static status_t sysclk_setup()
 
 	port = sysclk;
 
-	arch_visor_call(fetch_dp, clock, 0, 0, &vres);
+	devprop_fetch_dp(clock, 0, &vres);
 
 	if(vres.status != success)
 	{
@@ -53,7 +54,7 @@ static status_t sysclk_setup()
 	}
 	port->base_clk = *((unsigned int *)vres.p);
 
-	arch_visor_call(fetch_dp, prci, 0, 0, &vres);
+	devprop_fetch_dp(prci, 0, &vres);
 
 	if(vres.status != success)
 	{
@@ -191,6 +192,12 @@ static void sysclk_configure_clk(call_arg_t a0, call_arg_t a1, call_arg_t a2 _UN
 
 	ret->p = 0;
 	ret->size = 0;
+	/*
+	 * Quiesce drivers which support runtime PM across the switch,
+	 * a veto only means that driver keeps running, so it is not
+	 * treated as failure of clock configuration.
+	 */
+	driver_suspend_all();
 	ret->status = sysclk_execute_pre_config_clk_callback();
 
 	lock_acquire(&sysclk_key);
@@ -219,6 +226,7 @@ static void sysclk_configure_clk(call_arg_t a0, call_arg_t a1, call_arg_t a2 _UN
 	arch_ei_restore_state(&ist);
 	lock_release(&sysclk_key);
 	ret->status |= sysclk_execute_post_config_clk_callback();
+	ret->status |= driver_resume_all();
 	return;
 }
 
@@ -14,6 +14,8 @@
 #include <stdint.h>
 #include <status.h>
 #include <arch.h>
+#include <syslog.h>
+#include <boottrace.h>
 #include <engine.h>
 
 const ccver_t FWVersion _SECTION(".version") =
@@ -58,7 +60,10 @@ _WEAK void play_secondary()
 
 void engine()
 {
+	boottrace_mark("engine");
 	plug();
+	boottrace_mark("plug");
+	boottrace_dump();
 
 	do
 		play();
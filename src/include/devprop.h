@@ -0,0 +1,31 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: devprop.h
+ * Description		: This file consists of prototypes of driver side
+ *			  device/software property cache
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#pragma once
+#define _DEVPROP_H_
+
+#include <stdint.h>
+#include <status.h>
+#include <resource.h>
+#include <visor_call.h>
+
+/*
+ * Properties handed out by fetch_sp/fetch_dp point into constant
+ * SP/DP trees, so the result of a visor call stays valid until the
+ * platform is reconfigured. These wrappers remember the result of
+ * the first call and serve repeated requests without trapping.
+ * Caller sees the same vret_t as it would from arch_visor_call.
+ */
+void devprop_fetch_sp(sw_devid_t dev, vret_t *ret);
+void devprop_fetch_dp(hw_devid_t dev, unsigned int index, vret_t *ret);
+void devprop_fetch_pmux(pinmux_t *pmux, vret_t *ret);
+void devprop_invalidate(vcall_id_t id, call_arg_t key);
+void devprop_invalidate_all(void);
@@ -12,6 +12,7 @@
 #define _DRIVER_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <status.h>
 #include <lock/lock.h>
 
@@ -21,29 +22,115 @@ typedef struct device
 	char name[15];
 	status_t (*driver_setup)(void);
 	status_t (*driver_exit)(void);
+	status_t (*driver_suspend)(void);
+	status_t (*driver_resume)(void);
+	const char * const *deps;
 	uint32_t sorder:8;
 	uint32_t eorder:8;
 	uint32_t exec:1;
 	uint32_t percpu:1;
+	uint32_t async:1;
+	uint32_t ready:1;
+	uint32_t defer:1;
+	uint32_t n_deps:4;
+	uint32_t suspended:1;
+	uint32_t pm_sys:1;
+	uint16_t hash;
 	lock_t key;
 } device_t;
 #pragma pack()
 
-#define INCLUDE_DRIVER(_name, _driver_setup, _driver_exit, _pcpu, _sorder, _eorder)		\
-	const device_t _name _SECTION(".driver") =			\
+#define _DRIVER_ENTRY(_name, _driver_setup, _driver_exit,		\
+		_driver_suspend, _driver_resume, _pcpu,			\
+		_sorder, _eorder, _async, _deps, _n_deps)		\
+	const device_t _name _SECTION(".driver." #_sorder) =		\
 	{								\
 		.name		= #_name,				\
 		.driver_setup	= _driver_setup,			\
 		.driver_exit	= _driver_exit,				\
+		.driver_suspend	= _driver_suspend,			\
+		.driver_resume	= _driver_resume,			\
+		.deps		= _deps,				\
 		.sorder		= _sorder,				\
 		.eorder		= _eorder,				\
 		.exec		= 0,					\
 		.percpu		= _pcpu,				\
-	}
+		.async		= _async,				\
+		.n_deps		= _n_deps,				\
+	};								\
+	const device_t * const _name##_exit_ref			\
+		_SECTION(".driver_exit." #_eorder) = &_name
+
+/*
+ * INCLUDE_DRIVER - Adds driver to the driver table
+ * Start and exit orders are encoded in section names so that the
+ * linker emits tables pre-sorted on them, _sorder and _eorder
+ * must hence be plain decimal literals in range of 0-255.
+ */
+#define INCLUDE_DRIVER(_name, _driver_setup, _driver_exit, _pcpu, _sorder, _eorder)		\
+	_DRIVER_ENTRY(_name, _driver_setup, _driver_exit, NULL, NULL,	\
+			_pcpu, _sorder, _eorder, 0, NULL, 0)
+
+/*
+ * INCLUDE_DRIVER_ASYNC - Adds driver which can be started out of
+ * order, see INCLUDE_DRIVER_DEPS
+ */
+#define INCLUDE_DRIVER_ASYNC(_name, _driver_setup, _driver_exit, _pcpu, _sorder, _eorder)	\
+	_DRIVER_ENTRY(_name, _driver_setup, _driver_exit, NULL, NULL,	\
+			_pcpu, _sorder, _eorder, 1, NULL, 0)
+
+/*
+ * INCLUDE_DRIVER_PM - Adds driver with runtime power management
+ * _driver_suspend quiesces the device (gate clocks, save registers)
+ * without releasing its resources and _driver_resume undoes it.
+ * Suspend can veto by returning error (say error_driver_busy), the
+ * driver is then left running. Both are called with driver lock
+ * held, possibly with interrupts masked, so they must not block or
+ * print. Not supported for percpu drivers.
+ */
+#define INCLUDE_DRIVER_PM(_name, _driver_setup, _driver_exit,		\
+		_driver_suspend, _driver_resume, _pcpu, _sorder, _eorder)	\
+	_DRIVER_ENTRY(_name, _driver_setup, _driver_exit,		\
+			_driver_suspend, _driver_resume, _pcpu,		\
+			_sorder, _eorder, 0, NULL, 0)
+
+/*
+ * INCLUDE_DRIVER_DEPS - Adds driver along with its dependencies
+ * Driver is started only after the named drivers (upto 15) are
+ * ready, else it is deferred and retried. Drivers not built into
+ * the image are treated as ready. Async drivers are not started in
+ * the ordered pass, they get picked by driver_setup_async or
+ * after all the ordered drivers are started.
+ */
+#define INCLUDE_DRIVER_DEPS(_name, _driver_setup, _driver_exit, _pcpu,	\
+		_sorder, _eorder, _async, _dep1, ...)			\
+	INCLUDE_DRIVER_PM_DEPS(_name, _driver_setup, _driver_exit,	\
+			NULL, NULL, _pcpu, _sorder, _eorder, _async,	\
+			_dep1, ##__VA_ARGS__)
+
+/*
+ * INCLUDE_DRIVER_PM_DEPS - INCLUDE_DRIVER_DEPS with power management
+ * callbacks, see INCLUDE_DRIVER_PM
+ */
+#define INCLUDE_DRIVER_PM_DEPS(_name, _driver_setup, _driver_exit,	\
+		_driver_suspend, _driver_resume, _pcpu, _sorder,	\
+		_eorder, _async, _dep1, ...)				\
+	static const char * const _name##_deps[] =			\
+		{_dep1, ##__VA_ARGS__};					\
+	_DRIVER_ENTRY(_name, _driver_setup, _driver_exit,		\
+			_driver_suspend, _driver_resume, _pcpu,		\
+			_sorder, _eorder, _async, _name##_deps,		\
+			sizeof(_name##_deps) / sizeof(_name##_deps[0]))
 
+device_t *driver_find(const char *);
 status_t driver_setup_all();
+status_t driver_setup_async();
 status_t driver_exit_all();
 status_t driver_setup(const char *);
 status_t driver_exit(const char *);
 status_t driver_register(device_t *);
 status_t driver_deregister(device_t *);
+status_t driver_suspend_all();
+status_t driver_resume_all();
+status_t driver_suspend(const char *);
+status_t driver_resume(const char *);
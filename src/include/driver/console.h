@@ -14,6 +14,7 @@
 typedef struct console
 {
 	status_t (*write)(const char);
+	status_t (*write_buf)(const char *, size_t);
 	status_t (*read)(char *);
 	status_t (*flush)(void);
 	unsigned int *payload_size;
@@ -23,6 +24,7 @@ status_t console_attach_device(status_t, console_t *);
 status_t console_release_device();
 status_t console_setup();
 status_t console_putc(const char);
+status_t console_write_buf(const char *, size_t);
 status_t console_puts(const char *);
 status_t console_getc(char *);
 status_t console_flush(void);
@@ -31,6 +33,7 @@ unsigned int console_get_payload_size(void);
 status_t logger_attach_device(status_t, console_t *);
 status_t logger_release_device();
 status_t logger_putc(const char);
+status_t logger_write_buf(const char *, size_t);
 
 #ifdef _STDIO_H_
 status_t logger_dprint(const FILE *);
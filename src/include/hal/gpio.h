@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <status.h>
+#include <resource.h>
 
 typedef uint64_t gpio_parallel_t;
 
@@ -42,6 +43,7 @@ typedef struct gpio_port
 } gpio_port_t;
 
 status_t gpio_pin_alloc(gpio_port_t *port, uint8_t portID, uint8_t pinID);
+status_t gpio_pmux_alloc(gpio_port_t *port, pinmux_t *pmux);
 status_t gpio_pin_mode(const gpio_port_t *port, gpio_mode_t mode);
 status_t gpio_pin_free(gpio_port_t *port);
 status_t gpio_pin_set(const gpio_port_t * port);
@@ -38,4 +38,5 @@ typedef enum timer_mode
 status_t timer_setup(const timer_port_t *port, unsigned int mode, unsigned int ps);
 status_t timer_shutdown(const timer_port_t *port);
 status_t timer_read(const timer_port_t *port, size_t *value);
+status_t timer_set_value(const timer_port_t *port, size_t value);
 status_t timer_pwm_set(const timer_port_t *port, bool invert, size_t value);
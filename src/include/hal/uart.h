@@ -49,12 +49,17 @@ typedef struct uart_port
 	const irqs_t *rx_irq;
 	void (*rx_handler)(void);
 #endif
+	unsigned int pm_ctx;
+	/* Receiver and its irq are kept running in suspend, to wake core */
+	bool rx_wake;
 } uart_port_t;
 
 
 status_t uart_get_properties(uart_port_t *, sw_devid_t);
 status_t uart_setup(uart_port_t *, direction_t, parity_t);
 status_t uart_shutdown(uart_port_t *);
+status_t uart_suspend(uart_port_t *);
+status_t uart_resume(uart_port_t *);
 bool uart_buffer_available(const uart_port_t *);
 void uart_tx_wait_till_done(const uart_port_t *);
 bool uart_rx_empty(const uart_port_t *);
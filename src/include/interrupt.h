@@ -12,15 +12,40 @@
 #define _INTERRUPT_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <resource.h>
 
-typedef struct int_wait
+/*
+ * Completion is signalled from ISR and consumed by the waiter. With
+ * an OS registered, waiter task is blocked on wait_q (owned by OS),
+ * else caller sleeps in wfi till signalled.
+ */
+typedef struct completion
+{
+	volatile uint8_t done;
+	volatile uint8_t waiting;
+	void *wait_q;
+} completion_t;
+
+typedef struct completion_ops
 {
-	uint8_t lock;
-} int_wait_t;
+	/* Called with irqs masked, returns error if caller can not block */
+	status_t (*block)(void **wait_q);
+	/* Called with irqs masked, makes a waiter on wait_q ready */
+	void (*wake)(void **wait_q);
+} completion_ops_t;
 
 status_t link_interrupt(int_module_t, unsigned int, void (*)(void));
 status_t unlink_interrupt(int_module_t, unsigned int);
-status_t wait_till_irq(int_wait_t *);
-status_t wait_lock(int_wait_t *);
-status_t wait_release_on_irq(int_wait_t *);
+status_t completion_register_ops(const completion_ops_t *);
+void completion_init(completion_t *);
+status_t completion_wait(completion_t *);
+void completion_signal(completion_t *);
+
+/**
+ * completion_pending - Returns true if a caller is waiting on it
+ */
+static inline bool completion_pending(const completion_t *c)
+{
+	return c->waiting != 0;
+}
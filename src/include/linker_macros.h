@@ -10,10 +10,17 @@
 
 #pragma once
 
+/*
+ * Drivers are placed in .driver.<sorder> and pointers to them in
+ * .driver_exit.<eorder>, both get sorted here in ascending order
+ */
 #define DRIVER_TABLE					\
 		PROVIDE(_driver_table_start = .);	\
-		KEEP(*(.driver))			\
-		PROVIDE(_driver_table_end = .);
+		KEEP(*(SORT_BY_INIT_PRIORITY(.driver.*)))	\
+		PROVIDE(_driver_table_end = .);		\
+		PROVIDE(_driver_exit_table_start = .);	\
+		KEEP(*(SORT_BY_INIT_PRIORITY(.driver_exit.*)))	\
+		PROVIDE(_driver_exit_table_end = .);
 
 #define VCALL_TABLE					\
 		PROVIDE(_vcall_table_start = .);	\
@@ -29,6 +29,7 @@ typedef enum status
 	error_driver_init_failed	= 0x0102,
 	error_driver_busy		= 0x0103,
 	error_driver_data		= 0x0104,
+	error_driver_defer		= 0x0105,
 /* Device related error */
 	error_device			= 0x0200,
 	error_device_id_inval		= 0x0201,
@@ -81,6 +82,7 @@ typedef enum status
 	error_os_panic_os_start_fail	= 0x0f07,
 	error_os_mutex_lock		= 0x0f08,
 	error_os_mutex_unlock		= 0x0f09,
+	error_os_evt_wait		= 0x0f0a,
 /* Mesg related error */
 	error_mesg			= 0x1000,
 	error_mesg_long			= 0x1001,
@@ -19,6 +19,7 @@ typedef enum vcall_id
 	set_sleep_mode			= 0x0003,
 	fetch_clk			= 0x0004,
 	config_clk			= 0x0005,
+	vcall_base_end,
 /* pthread related */
 	pthread_barrier_destroy		= 0x1001,
 	pthread_barrier_init,
@@ -44,6 +45,7 @@ typedef enum vcall_id
 	pthread_self,
 	pthread_setschedparam,
 	pthread_delay_ticks,
+	vcall_pthread_end,
 /* mqueue related */
 	mq_close			= 0x2001,
 	mq_setattr,
@@ -62,4 +64,12 @@ typedef enum vcall_id
 	sched_get_max_priority,
 	sched_get_min_priority,
 	sched_yield,
+	vcall_ipc_end,
 } vcall_id_t;
+
+/*
+ * IDs are grouped in blocks of 0x1000, *_end entries mark the
+ * end of each group and are used to size the dispatch table
+ */
+#define VCALL_GRP_SHIFT			12
+#define VCALL_GRP_MASK			((1U << VCALL_GRP_SHIFT) - 1)
@@ -18,5 +18,6 @@
 #include <terravisor/helios/helios_tasks.h>
 #include <terravisor/helios/helios_sem.h>
 #include <terravisor/helios/helios_mutex.h>
+#include <terravisor/helios/helios_evt.h>
 
 #endif	/* __HELIOS__ */
@@ -0,0 +1,119 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: helios_evt.h
+ * Description		: CC OS event group declaration
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#pragma once
+/*****************************************************
+ *	DEFINES
+ *****************************************************/
+#include <terravisor/helios/helios.h>
+/*****************************************************
+ *	TYPEDEFS
+ *****************************************************/
+typedef enum
+{
+	helios_evt_wait_any	= 0x00,			///> Wake on any of the bits
+	helios_evt_wait_all	= 0x01,			///> Wake when all the bits are set
+	helios_evt_auto_clear	= 0x02,			///> Clear the waited bits on wake
+} helios_evt_opt_t;
+
+typedef struct helios_evt
+{
+	uint32_t evt_bits;
+	uint8_t	evt_init;
+	helios_sched_tcb_t * wait_q;		///> Waiting tasks, highest priority first
+}helios_evt_t;
+/*****************************************************
+ *	USER MACROS
+ *****************************************************/
+#define CC_EVT_INST(_Name)	_Name##_evt_inst
+
+#if HELIOS_DYNAMIC == false
+#define CC_EVT_DEF(_Name)		\
+static helios_evt_t _Name##_evt = {	\
+	.evt_init = 0,			\
+	.evt_bits = 0,			\
+	.wait_q = HELIOS_NULL_PTR	\
+};					\
+helios_evt_t * _Name##_evt_inst = &_Name##_evt
+#else
+#define CC_EVT_DEF(_Name)		helios_evt_t * _Name##_evt_inst = HELIOS_NULL_PTR
+#endif
+/*****************************************************
+ *	USER FUNCTION DECLARATIONS
+ *****************************************************/
+/**
+ * @brief 	Create an event group with all bits cleared
+ * @note	The instance needs to be provided using CC_EVT_DEF macro
+ *
+ * @param evt_ptr[in_out]	Instance pointer
+ *
+ * @return status_t
+ */
+status_t helios_evt_create	(helios_evt_t ** evt_ptr);
+
+/**
+ * @brief 	Delete an event group
+ * @note	Fails if tasks are still waiting on it
+ *
+ * @param evt_ptr[in_out]	Instance pointer
+ *
+ * @return status_t
+ */
+status_t helios_evt_delete	(helios_evt_t ** evt_ptr);
+
+/**
+ * @brief 	Set event bits
+ * @note	Can be called from ISR. Every waiter whose condition is met
+ *		is made ready by this call, auto-clear bits are cleared
+ *		once all the waiters are served.
+ *
+ * @param evt_ptr[in]		Instance pointer
+ * @param bits[in]		Bits to set
+ *
+ * @return status_t
+ */
+status_t helios_evt_set		(helios_evt_t * evt_ptr, uint32_t bits);
+
+/**
+ * @brief 	Clear event bits
+ * @note	Can be called from ISR
+ *
+ * @param evt_ptr[in]		Instance pointer
+ * @param bits[in]		Bits to clear
+ *
+ * @return status_t
+ */
+status_t helios_evt_clear	(helios_evt_t * evt_ptr, uint32_t bits);
+
+/**
+ * @brief 	Wait for event bits
+ * @note	Waiting tasks are queued in priority order. Must not wait
+ *		when called from ISR.
+ *
+ * @param evt_ptr[in]		Instance pointer
+ * @param bits[in]		Bits to wait on
+ * @param opt[in]		helios_evt_wait_any/all, or'ed with helios_evt_auto_clear
+ * @param val[out]		Event bits which satisfied the wait, can be NULL
+ * @param wait_ticks[in]	Timeout Wait ticks
+ *
+ * @return status_t
+ */
+status_t helios_evt_wait	(helios_evt_t * evt_ptr, uint32_t bits, uint8_t opt,
+				 uint32_t * val, size_t wait_ticks);
+
+/**
+ * @brief 	Get current event bits
+ *
+ * @param evt_ptr[in]		Instance pointer
+ * @param val[out]		Value return
+ *
+ * @return status_t
+ */
+status_t helios_evt_get_val	(const helios_evt_t * evt_ptr, uint32_t * val);
@@ -21,6 +21,7 @@ typedef struct helios_mutex
 	int mutex_val;
 	uint8_t	mutex_init;
 	helios_sched_tcb_t * lock_task;
+	helios_sched_tcb_t * wait_q;		///> Waiting tasks, highest priority first
 } helios_mutex_t;
 /*****************************************************
  *	USER MACROS
@@ -32,7 +33,8 @@ typedef struct helios_mutex
 static helios_mutex_t _Name##_mutex = {	\
 	.mutex_init = 0,		\
 	.mutex_val = 0,			\
-	.lock_task = HELIOS_NULL_PTR	\
+	.lock_task = HELIOS_NULL_PTR,	\
+	.wait_q = HELIOS_NULL_PTR	\
 };					\
 helios_mutex_t * _Name##_mutex_inst = &_Name##_mutex
 #else
@@ -53,7 +55,7 @@ status_t helios_mutex_create	(helios_mutex_t ** mutex_ptr);
 
 /**
  * @brief 	Delete a mutex and de-initialise it
- * @note	Free the mutex struct and clear the mutex_init to de-initialize the mutex.
+ * @note	Free the mutex struct and clear the mutex_init to de-initialize the mutex. Fails if the mutex is locked or tasks are waiting on it.
  *
  * @param mutex_ptr[in_out]	Instance pointer
  *
@@ -63,7 +65,7 @@ status_t helios_mutex_delete 	(helios_mutex_t ** mutex_ptr);
 
 /**
  * @brief 	Unlock the mutex
- * @note	Increment the mutex_val to unlock. Unlock only if called by the current task. If any other task tries to unlock the mutex, return an error.
+ * @note	Increment the mutex_val to unlock. Unlock only if called by the current task. If any other task tries to unlock the mutex, return an error. On release the mutex is handed directly to the highest priority waiter and inherited priority is dropped.
  *
  * @param mutex_ptr[in]		Instance pointer
  *
@@ -73,7 +75,7 @@ status_t helios_mutex_unlock 	(helios_mutex_t * mutex_ptr);
 
 /**
  * @brief 	Lock a mutex
- * @note	Decrement the mutex_val to lock. If resource already taken by another task, wait for wait_ticks until free. Allow recursive mutex if same task requires the mutex again.
+ * @note	Decrement the mutex_val to lock. If resource already taken by another task, wait for wait_ticks until free. Allow recursive mutex if same task requires the mutex again. While waiting, the owner inherits the priority of the waiting task.
  *
  * @param mutex_ptr[in]		Instance pointer
  * @param wait_ticks[in]	Timeout Wait ticks
@@ -20,6 +20,7 @@ typedef struct helios_sem
 {
 	size_t	sem_val;
 	uint8_t	sem_init;
+	helios_sched_tcb_t * wait_q;		///> Waiting tasks, highest priority first
 }helios_sem_t;
 /*****************************************************
  *	USER MACROS
@@ -30,7 +31,8 @@ typedef struct helios_sem
 #define CC_SEM_DEF(_Name)		\
 static helios_sem_t _Name##_sem = {	\
 	.sem_init = 0,			\
-	.sem_val = 0			\
+	.sem_val = 0,			\
+	.wait_q = HELIOS_NULL_PTR	\
 };					\
 helios_sem_t * _Name##_sem_inst = &_Name##_sem
 #else
@@ -52,6 +54,7 @@ status_t helios_sem_create	(helios_sem_t ** sem_ptr, size_t init_val);
 
 /**
  * @brief 	Delete a semaphore and de-initialise it
+ * @note	Fails if tasks are still waiting on it
  *
  * @param sem_ptr[in_out]	Instance pointer
  *
@@ -61,6 +64,8 @@ status_t helios_sem_delete 	(helios_sem_t ** sem_ptr);
 
 /**
  * @brief 	Decrement a semaphore value
+ * @note	If tasks are waiting, the count is handed to the highest
+ *		priority waiter instead.
  *
  * @param sem_ptr[in]		Instance pointer
  *
@@ -70,6 +75,8 @@ status_t helios_sem_give 	(helios_sem_t * sem_ptr);
 
 /**
  * @brief 	Increment a semaphore value
+ * @note	Waiting tasks are queued in priority order. Must not wait
+ *		when called from ISR.
  *
  * @param sem_ptr[in]		Instance pointer
  * @param wait_ticks[in]	Timeout Wait ticks
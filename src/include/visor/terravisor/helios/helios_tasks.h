@@ -36,13 +36,14 @@ typedef uint16_t helios_task_t;
  *****************************************************/
 /**
  * @brief A Function to add a task to the scheduler
- *
+ * @note  Task runs on its own stack which also holds its context when
+ *	  switched out. Returning from task_func terminates the task.
  *
  * @param helios_task[out]	Pointer to the TASK_instance
  * @param name[in]		Conatant Name string provided by the user
  * @param task_func[in]		Pointer to the task function
  * @param args[in]		Pointer to the argument variable provided to the task
- * @param priority[in]		Task Priority: 1->255
+ * @param priority[in]		Task Priority: 1->(HELIOS_PRIORITY_LEVELS - 1)
  * @param stack_len[in]		Task stack length
  * @param stack_ptr[in]		Pointer to static stack for static allocation only.
  *
@@ -148,6 +149,7 @@ void helios_task_wait(const size_t ticks);
 
 /**
  * @brief A Function to switch to next available task
+ * @note  Tasks are also preempted every HELIOS_TICK_MS by the timer tick
  *
  * @return None
  */
@@ -8,10 +8,45 @@
  * Organisation		: Cyancore Core-Team
  */
 
+#pragma once
+
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 #include <terravisor/helios/helios.h>
 
+/**
+ * @brief	Kernel objects served from fixed block pools
+ */
+typedef enum
+{
+	helios_obj_tcb		= 0x00,
+	helios_obj_sem		= 0x01,
+	helios_obj_mutex	= 0x02,
+	helios_obj_evt		= 0x03,
+	helios_obj_max
+} helios_obj_t;
+
 void * helios_malloc(size_t size);
 void helios_free(void *addr);
+
+/**
+ * @brief	Allocate a kernel object
+ * @note	Served from the object pool in O(1), falls back to heap
+ *		once the pool is exhausted.
+ *
+ * @param obj[in]	Object type
+ *
+ * @return Object address, NULL if memory is low
+ */
+void * helios_obj_alloc(helios_obj_t obj);
+
+/**
+ * @brief	Free a kernel object allocated by helios_obj_alloc
+ *
+ * @param obj[in]	Object type
+ * @param addr[in]	Object address
+ *
+ * @return None
+ */
+void helios_obj_free(helios_obj_t obj, void *addr);
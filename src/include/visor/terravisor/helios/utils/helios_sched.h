@@ -14,19 +14,42 @@
  *	INCLUDES
  *****************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <status.h>
 #include <syslog.h>
+#include <arch.h>
 #include <platform.h>
 
 /*****************************************************
  *	DEFINES
  *****************************************************/
 #define HELIOS_NULL_PTR			NULL
-#define HELIOS_DELAY_MAX		SIZE_MAX
+#define HELIOS_DELAY_MAX		SIZE_MAX		///> Wait forever
+/* Deadlines are compared wrap safe, so a delay must be less than half the tick range */
+#define HELIOS_DELAY_LIMIT		((helios_tick_t) INT32_MAX)
+#define HELIOS_TICK_AFTER(_a, _b)	((int32_t)((_b) - (_a)) < 0)
+#define HELIOS_DEADLINE(_now, _ticks)	((_now) + (((_ticks) < HELIOS_DELAY_LIMIT) ?	\
+					(helios_tick_t)(_ticks) : HELIOS_DELAY_LIMIT))
 
 #define	HELIOS_DYNAMIC 			HELIOS_USE_DYNAMIC
 
+#if (HELIOS_PRIORITY_LEVELS > 256) || (HELIOS_PRIORITY_LEVELS <= HELIOS_IDLE_TASK_PRIORITY)
+#error "HELIOS_PRIORITY_LEVELS must be within (HELIOS_IDLE_TASK_PRIORITY, 256]"
+#endif
+
+/* Number of 32bit words needed to map all the priority levels */
+#define HELIOS_PRIO_MAP_WORDS		((HELIOS_PRIORITY_LEVELS + 31) / 32)
+
+#define HELIOS_LINK_READY		0x00
+#define HELIOS_LINK_WAIT		0x01
+#define HELIOS_LINK_TASK		0x02
+#define HELIOS_LINK_RES			0x03
+
+/* Kernel data is shared with the tick ISR, guard it by masking interrupts */
+#define HELIOS_ENTER_CRITICAL(_istate)	arch_di_save_state(_istate)
+#define HELIOS_EXIT_CRITICAL(_istate)	arch_ei_restore_state(_istate)
+
 #ifdef HELIOS_DEBUG
 #define HELIOS_ERR(fmt, ...)		sysdbg2("[HELIOS ERR]: "fmt"\n", ##__VA_ARGS__)
 #define HELIOS_DBG(fmt, ...)		sysdbg3("[HELIOS DBG]: "fmt"\n", ##__VA_ARGS__)
@@ -55,6 +78,7 @@ typedef struct helios_sched_tcb helios_sched_tcb_t;
 typedef struct helios_sched helios_sched_t;
 typedef const char c_char;
 typedef uintptr_t helios_args;
+typedef uint32_t helios_tick_t;
 typedef void (*task_fn_t)(void);
 typedef void (*helios_cb_hook_t)(helios_args args);
 typedef enum
@@ -92,21 +116,32 @@ typedef struct link
 typedef struct wres
 {
 	uintptr_t wait_on_resource;				///> Resource on hich the task is waiting on
-	size_t 	  task_delay_ticks;				///> Time delay in ticks
+	helios_sched_tcb_t ** wait_q;				///> Waiter list head of the resource
+	helios_sched_tcb_t ** wait_owner;			///> Owner field of the resource, for priority inheritance
+	helios_tick_t wake_tick;				///> Absolute tick at which wait times out
+	bool handoff;						///> Resource handed over directly on release
+	uint8_t evt_opt;					///> Event group wait options
+	uint32_t evt_bits;					///> Event bits waited on, bits seen when woken
 }wres_t;
 
 struct helios_sched_tcb
 {
 
 	c_char  * name;						///> Name of the Current Task
-	uint8_t   priority;					///> Priority of the task
+	uint8_t   priority;					///> Priority of the task (may be inherited)
+	uint8_t   base_priority;				///> Priority assigned at task creation
+	uint8_t   mutex_held;					///> Number of mutexes currently held
 	uint8_t	  task_flags;					///> Task Flags
-	uintptr_t stack_ptr;					///> Stack Pointer
+	uintptr_t stack_ptr;					///> Saved Stack Pointer
+	uintptr_t stack_base;					///> Lowest address of the task stack
+	size_t	  stack_len;					///> Length of the task stack
 	task_fn_t task_func;					///> Task Call Function
 	uintptr_t args_ptr;					///> Task Call argument ptr
 	wres_t	  wait_res;					///> Wait Task resource
-	link_t	  ready_link;					///> Ready Linked List Pointers
-	link_t    wait_link;					///> Wait Linked List Pointers
+	link_t	  ready_link;					///> Ready queue (per priority FIFO) Pointers
+	link_t    wait_link;					///> Delay list (sorted on wake tick) Pointers
+	link_t    res_link;					///> Resource waiter list (sorted on priority) Pointers
+	link_t    task_link;					///> Task List (all created tasks) Pointers
 	uint16_t  task_id;					///> Task ID assigned
 #if HELIOS_ANTI_DEADLOCK
 	size_t	  task_wd_ticks;				///> Tick down counter for Anti Deadlock system
@@ -127,13 +162,35 @@ typedef struct helios_sched_func_cb
 #endif /* HELIOS_ANTI_DEADLOCK */
 }helios_sched_func_cb_t;
 
+/**
+ * @brief	Ready queue
+ * @note	Every priority level has its own FIFO ring of ready tasks.
+ *		prio_map has bit 'n' set when level 'n' is non-empty and
+ *		prio_grp has bit 'w' set when prio_map[w] is non-zero, so the
+ *		highest ready level is found with two count-leading-zeros.
+ */
+typedef struct helios_ready_queue
+{
+	helios_sched_tcb_t	* prio_head[HELIOS_PRIORITY_LEVELS];	///> Head of FIFO per priority
+	uint32_t		  prio_map[HELIOS_PRIO_MAP_WORDS];	///> Non-empty priority bitmap
+	uint8_t			  prio_grp;				///> Non-zero prio_map word bitmap
+}helios_ready_queue_t;
+
 typedef struct helios_sched_ctrl
 {
-	helios_sched_tcb_t 	* ready_list_head;
+	helios_ready_queue_t	ready_q;
+	helios_sched_tcb_t 	* task_list_head;			///> All tasks, in the order they were added
+	helios_sched_tcb_t 	* idle_task;				///> IDLE task, set by helios_run
 	helios_sched_tcb_t 	* curr_task;
-	helios_sched_tcb_t 	* wait_list_head;
+	helios_sched_tcb_t 	* delay_list_head;			///> Timed waits, earliest wake tick first
 	helios_sched_t 		* selected_sched;
 	helios_sched_func_cb_t cb_hooks_reg;
+	bool			preempt_pending;		///> Set by tick, consumed on irq exit
+	volatile helios_tick_t	tick_count;			///> Ticks elapsed since helios_run
+#if HELIOS_POWER_SAVE_EN
+	helios_tick_t		sleep_ticks;			///> Ticks the tick is stretched by, 0 if not sleeping
+	uint32_t		sleep_rem_us;			///> Part of a tick slept but not yet accounted
+#endif /* HELIOS_POWER_SAVE_EN */
 }helios_sched_ctrl_t;
 
 /**
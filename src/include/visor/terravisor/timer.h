@@ -24,3 +24,4 @@ typedef struct tvisor_timer
 status_t timer_attach_device(status_t, tvisor_timer_t *);
 status_t timer_release_device();
 status_t timer_link_callback(unsigned int, void *);
+status_t timer_set_period(unsigned int);
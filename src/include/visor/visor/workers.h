@@ -11,3 +11,4 @@
 #pragma once
 
 void vcall_handler(unsigned int, unsigned int, unsigned int, unsigned int, vret_t *);
+void vcall_stats_dump(void);
@@ -22,5 +22,9 @@ $(eval $(call add_define,N_STDDEV))
 USE_FLOAT	?= 1
 $(eval $(call add_define,USE_FLOAT))
 
+# malloc splits every power of 2 size class in 2^HEAP_SL_LOG2 free lists
+HEAP_SL_LOG2	?= 2
+$(eval $(call add_define,HEAP_SL_LOG2))
+
 DIR		:= $(LIBC_PATH)
 include mk/lib.mk
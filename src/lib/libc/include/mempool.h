@@ -0,0 +1,56 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: mempool.h
+ * Description		: This file contains prototypes of fixed block
+ *			  memory pool allocator
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#pragma once
+#define _MEMPOOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <status.h>
+#include <lock/lock.h>
+
+typedef struct mempool
+{
+	void *free_list;
+	uint8_t *base;
+	size_t blk_size;
+	size_t n_blks;
+	size_t next;
+	size_t used;
+	lock_t key;
+} mempool_t;
+
+/*
+ * INCLUDE_MEMPOOL - Declares a pool of _count blocks of _type
+ * Storage is reserved at compile time. Blocks which were never
+ * allocated are handed out in order, freed blocks are linked
+ * through their first word, so no init call is needed.
+ */
+#define INCLUDE_MEMPOOL(_name, _type, _count)				\
+	static union							\
+	{								\
+		_type obj;						\
+		void *link;						\
+	} _name##_blks[_count];						\
+	mempool_t _name =						\
+	{								\
+		.free_list	= NULL,					\
+		.base		= (uint8_t *) _name##_blks,		\
+		.blk_size	= sizeof(_name##_blks[0]),		\
+		.n_blks		= _count,				\
+		.next		= 0,					\
+		.used		= 0,					\
+	}
+
+void *mempool_alloc(mempool_t *);
+status_t mempool_free(mempool_t *, void *);
+bool mempool_owns(const mempool_t *, const void *);
@@ -16,3 +16,6 @@ status_t stdin_register(status_t (*)(char *));
 status_t stdout_register(status_t (*)(const char));
 status_t stderr_register(status_t (*)(const char));
 status_t stdlog_register(status_t (*)(const char));
+status_t stdout_register_buf(status_t (*)(const char *, size_t), status_t (*)(void));
+status_t stderr_register_buf(status_t (*)(const char *, size_t), status_t (*)(void));
+status_t stdlog_register_buf(status_t (*)(const char *, size_t), status_t (*)(void));
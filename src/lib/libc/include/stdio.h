@@ -33,6 +33,7 @@ int __eprintf(const char *fmt, ...);
 int scanf(const char *fmt, ...);
 int fputs(const FILE *, const char *);
 int fputc(const FILE *, const char);
+int fflush(const FILE *);
 int fgetc(const FILE *, char *);
 char getch();
 char getchar();
@@ -4,7 +4,8 @@
  *
  * File Name		: malloc_lite.c
  * Description		: This file contains sources of libc-malloc
- *			  functions
+ *			  functions, implemented as Two Level Segregated
+ *			  Fit (TLSF) allocator
  * Primary Author	: Akash Kollipara [akashkollipara@gmail.com]
  * Organisation		: Cyancore Core-Team
  */
@@ -19,27 +20,60 @@
 #include <mmio.h>
 #include <plat_mem.h>
 
+/*
+ * Free blocks are kept in segregated lists indexed by two levels,
+ * first level is the power of 2 class of block size and second level
+ * splits every class in 2^HEAP_SL_LOG2 linear ranges. Non-empty lists
+ * are tracked in bitmaps so that a fitting list is found using bit
+ * scans. Every block knows its physical neighbours (boundary tags),
+ * hence malloc and free are constant time irrespective of heap state.
+ */
+#define BLK_ALIGN	((HEAP_ALIGN > sizeof(size_t)) ? HEAP_ALIGN : sizeof(size_t))
+#define BLK_ALIGN_LOG2	((BLK_ALIGN >= 8) ? 3 : ((BLK_ALIGN >= 4) ? 2 : 1))
+#define BLK_FREE	((size_t) 1)
+#define BLK_HDR		(sizeof(block_t) - (2 * sizeof(block_t *)))
+#define BLK_MIN		(2 * sizeof(block_t *))
+
+#define SL_LOG2		HEAP_SL_LOG2
+#define SL_COUNT	(1U << SL_LOG2)
+#define FL_SHIFT	(SL_LOG2 + BLK_ALIGN_LOG2)
+#define SMALL_BLOCK	((size_t) 1 << FL_SHIFT)
+
+#if SL_LOG2 > 3
+#error "HEAP_SL_LOG2 must be within [0, 3]"
+#endif
+
 extern uint8_t _heap_start, _heap_end, _heap_size;
+/* Larger requests can never be served, rejected before rounding wraps */
+#define HEAP_MAX_REQ	((size_t)&_heap_size)
 static istate_t state;
 static lock_t mlock;
 
-typedef struct chunk
+typedef struct block
 {
+	struct block *prev_phys;
 	size_t size;
-#if HEAP_ALIGN > 1
-	size_t free;
-#else
-	uint8_t free;
-#endif
-	struct chunk *next;
-} chunk_t;
+	/* Free list links, overlap the payload of used block */
+	struct block *next_free;
+	struct block *prev_free;
+} block_t;
 
-static chunk_t *freeList;
+static size_t fl_bitmap;
+static uint8_t fl_count;
+static uint8_t *sl_bitmap;
+static block_t **free_heads;
+static block_t *first_block;
+static size_t used;
+/* Heap beyond this mark was never handed out since init */
+static size_t clean_mark;
 
 static void heap_lock(void)
 {
+	istate_t ist;
+	/* Mask irqs first, lock holder must not be preempted */
+	arch_di_save_state(&ist);
 	lock_acquire(&mlock);
-	arch_di_save_state(&state);
+	state = ist;
 }
 
 static void heap_unlock(void)
@@ -48,95 +82,281 @@ static void heap_unlock(void)
 	arch_ei_restore_state(&state);
 }
 
-static void split(chunk_t *fit_slot, size_t size)
+static inline unsigned int heap_fls(size_t x)
 {
-	chunk_t *new = (chunk_t *)((size_t) fit_slot + size + sizeof(chunk_t));
-	new->size = fit_slot->size - size - sizeof(chunk_t);
-	new->free = 1;
-	new->next = fit_slot->next;
-	fit_slot->size = size;
-	fit_slot->free = 0;
-	fit_slot->next = new;
-	return;
+	return (sizeof(unsigned int) * 8) - 1 - __builtin_clz(x);
+}
+
+static inline unsigned int heap_ffs(size_t x)
+{
+	return __builtin_ctz(x);
+}
+
+static inline size_t align_up(size_t x)
+{
+	return (x + BLK_ALIGN - 1) & ~(BLK_ALIGN - 1);
+}
+
+static inline size_t block_size(const block_t *blk)
+{
+	return blk->size & ~BLK_FREE;
+}
+
+static inline bool block_is_free(const block_t *blk)
+{
+	return blk->size & BLK_FREE;
+}
+
+static inline block_t *block_next(const block_t *blk)
+{
+	return (block_t *)((size_t) blk + BLK_HDR + block_size(blk));
+}
+
+static inline void *block_payload(const block_t *blk)
+{
+	return (void *)((size_t) blk + BLK_HDR);
+}
+
+static inline block_t *get_header(const void *p)
+{
+	return (block_t *)((size_t) p - BLK_HDR);
 }
 
-static void merge()
+static void mapping(size_t size, unsigned int *fl, unsigned int *sl)
 {
-	chunk_t *cur;
-	cur = freeList;
-	while(cur && cur->next)
+	unsigned int f;
+	if(size < SMALL_BLOCK)
 	{
-		if(cur->free && cur->next->free)
-		{
-			cur->size += cur->next->size + sizeof(chunk_t);
-			cur->next = cur->next->next;
-		}
-		cur = cur->next;
+		*fl = 0;
+		*sl = size >> BLK_ALIGN_LOG2;
+		return;
+	}
+	f = heap_fls(size);
+	*sl = (size >> (f - SL_LOG2)) ^ SL_COUNT;
+	*fl = f - FL_SHIFT + 1;
+}
+
+static void block_insert(block_t *blk)
+{
+	unsigned int fl, sl;
+	block_t **head;
+	mapping(block_size(blk), &fl, &sl);
+	head = &free_heads[(fl * SL_COUNT) + sl];
+	blk->prev_free = NULL;
+	blk->next_free = *head;
+	if(*head)
+		(*head)->prev_free = blk;
+	*head = blk;
+	sl_bitmap[fl] |= (uint8_t)(1U << sl);
+	fl_bitmap |= ((size_t) 1 << fl);
+}
+
+static void block_remove(block_t *blk)
+{
+	unsigned int fl, sl;
+	block_t **head;
+	mapping(block_size(blk), &fl, &sl);
+	head = &free_heads[(fl * SL_COUNT) + sl];
+	if(blk->next_free)
+		blk->next_free->prev_free = blk->prev_free;
+	if(blk->prev_free)
+		blk->prev_free->next_free = blk->next_free;
+	else
+		*head = blk->next_free;
+	if(*head == NULL)
+	{
+		sl_bitmap[fl] &= (uint8_t)~(1U << sl);
+		if(!sl_bitmap[fl])
+			fl_bitmap &= ~((size_t) 1 << fl);
+	}
+}
+
+/*
+ * Finds a free block from the list of size class 'size' or above.
+ * Size is rounded up to next list boundary so that any block of the
+ * selected list fits the request (good fit, no list walk). If no such
+ * list has a block, head of the exact list is taken when it is large
+ * enough, else requests near the heap size fail with room left.
+ */
+static block_t *block_find(size_t size)
+{
+	unsigned int fl, sl;
+	size_t map, round;
+	block_t *fit;
+
+	mapping(size, &fl, &sl);
+	if(fl >= fl_count)
+		return NULL;
+	fit = free_heads[(fl * SL_COUNT) + sl];
+	if(fit && (block_size(fit) < size))
+		fit = NULL;
+
+	if(size >= SMALL_BLOCK)
+	{
+		round = ((size_t) 1 << (heap_fls(size) - SL_LOG2)) - 1;
+		if(size > (~(size_t) 0 - round))
+			return fit;
+		size += round;
+	}
+	mapping(size, &fl, &sl);
+	if(fl >= fl_count)
+		return fit;
+
+	map = sl_bitmap[fl] & (~0U << sl);
+	if(!map)
+	{
+		if(fl + 1 >= sizeof(size_t) * 8)
+			return fit;
+		map = fl_bitmap & (~(size_t) 0 << (fl + 1));
+		if(!map)
+			return fit;
+		fl = heap_ffs(map);
+		map = sl_bitmap[fl];
 	}
+	sl = heap_ffs(map);
+	return free_heads[(fl * SL_COUNT) + sl];
+}
+
+static void split(block_t *blk, size_t size)
+{
+	block_t *rem;
+	if(block_size(blk) < (size + BLK_HDR + BLK_MIN))
+		return;
+	rem = (block_t *)((size_t) blk + BLK_HDR + size);
+	rem->size = (block_size(blk) - size - BLK_HDR) | BLK_FREE;
+	rem->prev_phys = blk;
+	block_next(rem)->prev_phys = rem;
+	blk->size = size | (blk->size & BLK_FREE);
+	block_insert(rem);
 }
 
-static chunk_t *get_header(void *p)
+static block_t *merge(block_t *blk)
 {
-	return (chunk_t *)p - 1;
+	block_t *prev = blk->prev_phys;
+	block_t *next = block_next(blk);
+
+	if(prev && block_is_free(prev))
+	{
+		block_remove(prev);
+		prev->size += BLK_HDR + block_size(blk);
+		blk = prev;
+		next->prev_phys = blk;
+	}
+	if(block_is_free(next))
+	{
+		block_remove(next);
+		blk->size += BLK_HDR + block_size(next);
+		block_next(blk)->prev_phys = blk;
+	}
+	return blk;
 }
 
 status_t platform_init_heap()
 {
+	size_t start, end, sz;
+	block_t *last;
+
 	heap_lock();
-	size_t sz = (size_t)&_heap_end;
-	sz -= (size_t)&_heap_start;
+	start = align_up((size_t)&_heap_start);
+	end = (size_t)&_heap_end & ~(BLK_ALIGN - 1);
+	sz = (size_t)&_heap_end - (size_t)&_heap_start;
 	memset(&_heap_start, 0, sz);
-	freeList = (void *)&_heap_start;
-	freeList->size = sz - sizeof(chunk_t);
-	freeList->free = 1;
-	freeList->next = NULL;
+	sz = end - start;
+
+	/* Control lists are placed at heap start, sized as per heap */
+	fl_count = (sz < SMALL_BLOCK) ? 1 : (uint8_t)(heap_fls(sz) - FL_SHIFT + 2);
+	fl_bitmap = 0;
+	sl_bitmap = (uint8_t *) start;
+	free_heads = (block_t **) align_up(start + fl_count);
+	first_block = (block_t *) align_up((size_t)&free_heads[fl_count * SL_COUNT]);
+
+	/* Zero sized used block at the end stops merging beyond heap */
+	last = (block_t *)(end - BLK_HDR);
+	if((size_t) first_block + BLK_HDR + BLK_MIN > (size_t) last)
+	{
+		first_block = NULL;
+		heap_unlock();
+		return error_memory_low;
+	}
+	first_block->prev_phys = NULL;
+	first_block->size = ((size_t) last - (size_t) first_block - BLK_HDR) | BLK_FREE;
+	last->prev_phys = first_block;
+	last->size = 0;
+	block_insert(first_block);
+	clean_mark = (size_t) first_block;
+	used = sz - (BLK_HDR + block_size(first_block));
 	heap_unlock();
 	return success;
 }
 
-void *malloc(size_t n_bytes)
+/* Returns 0 if request is larger than the heap */
+static inline size_t req_size(size_t n_bytes)
+{
+	if(n_bytes > HEAP_MAX_REQ)
+		return 0;
+	n_bytes = align_up(n_bytes);
+	return (n_bytes < BLK_MIN) ? BLK_MIN : n_bytes;
+}
+
+static void mark_dirty(const block_t *blk)
 {
-	chunk_t *cur;
+	size_t end = (size_t) block_next(blk);
+	if(end > clean_mark)
+		clean_mark = end;
+}
+
+/*
+ * Allocates a block and reports if its payload is still zero
+ * as left by platform_init_heap, except for the free list links
+ * which were kept in the first BLK_MIN bytes.
+ */
+static void *heap_alloc(size_t n_bytes, bool *clean)
+{
+	block_t *blk;
 	void *p = NULL;
 
-	if(!n_bytes)
+	if(!n_bytes || !first_block)
 		return NULL;
 
-#if HEAP_ALIGN > 1
-	ROUNDUP_ALIGN(n_bytes, ALIGN_BOUND);
-#endif
+	n_bytes = req_size(n_bytes);
+	if(!n_bytes)
+		return NULL;
 
 	heap_lock();
-	if(!freeList->size)
-		goto exit;
-	cur = freeList;
-	while(cur->size < n_bytes || (!cur->free && cur->next))
-		cur = cur->next;
-	if(cur->size == n_bytes)
-		cur->free = 0;
-	else if(cur->size > (n_bytes + sizeof(chunk_t)))
-		split(cur, n_bytes);
-	else
+	blk = block_find(n_bytes);
+	if(!blk)
 		goto exit;
-	p = (void *)(++cur);
+	block_remove(blk);
+	split(blk, n_bytes);
+	blk->size &= ~BLK_FREE;
+	used += BLK_HDR + block_size(blk);
+	if(clean)
+		*clean = ((size_t) blk >= clean_mark);
+	mark_dirty(blk);
+	p = block_payload(blk);
 exit:
 	heap_unlock();
 	return p;
 }
 
+void *malloc(size_t n_bytes)
+{
+	return heap_alloc(n_bytes, NULL);
+}
+
 void free(void *ptr)
 {
 	if(ptr == NULL)
 		return;
 
-	chunk_t *cur = get_header(ptr);
+	block_t *cur = get_header(ptr);
 	heap_lock();
-	if((void *)&_heap_start <= (void *)cur &&
-		(void *)cur <= (void *)&_heap_end)
+	if((void *)first_block <= (void *)cur &&
+		(void *)cur < (void *)&_heap_end && !block_is_free(cur))
 	{
-		cur->free = 1;
-		merge();
-		merge();
+		used -= BLK_HDR + block_size(cur);
+		cur->size |= BLK_FREE;
+		block_insert(merge(cur));
 	}
 	heap_unlock();
 	return;
@@ -144,15 +364,31 @@ void free(void *ptr)
 
 void *calloc(size_t n_blocks, size_t n_bytes)
 {
+	bool clean = false;
+	void *p;
+
+	if(n_blocks && (n_bytes > (~(size_t) 0 / n_blocks)))
+		return NULL;
 	n_bytes *= n_blocks;
-	void *p = malloc(n_bytes);
+	if(n_bytes > HEAP_MAX_REQ)
+		return NULL;
+	p = heap_alloc(n_bytes, &clean);
 	if(p)
-		memset(p, 0, n_bytes);
+		memset(p, 0, clean ? BLK_MIN : n_bytes);
 	return p;
 }
 
+/*
+ * Resizes the block in place when possible, shrinking gives back
+ * the tail and growing absorbs the next physical block if it is free.
+ * Only when neither works the data is moved to a new block.
+ */
 void *realloc(void *p, size_t n_bytes)
 {
+	block_t *blk, *next;
+	size_t old_size, size;
+	void *new_p;
+
 	if(!p)
 		return malloc(n_bytes);
 	if(!n_bytes)
@@ -161,26 +397,52 @@ void *realloc(void *p, size_t n_bytes)
 		return NULL;
 	}
 
-	chunk_t *header = get_header(p);
-	void *new_p = malloc(n_bytes);
+	/* Block is left untouched if request can not be met */
+	size = req_size(n_bytes);
+	if(!size)
+		return NULL;
+	blk = get_header(p);
+
+	heap_lock();
+	old_size = block_size(blk);
+	next = block_next(blk);
+	if(size > old_size)
+	{
+		if(!block_is_free(next) ||
+			(old_size + BLK_HDR + block_size(next)) < size)
+		{
+			heap_unlock();
+			goto move;
+		}
+		block_remove(next);
+		blk->size += BLK_HDR + block_size(next);
+		block_next(blk)->prev_phys = blk;
+	}
+	split(blk, size);
+	next = block_next(blk);
+	if(block_is_free(next))
+	{
+		/* Tail given back may border another free block */
+		block_remove(next);
+		block_insert(merge(next));
+	}
+	used = used + block_size(blk) - old_size;
+	mark_dirty(blk);
+	heap_unlock();
+	return p;
+
+move:
+	new_p = malloc(n_bytes);
 	if(!new_p)
 		return NULL;
-	memcpy(new_p, p, header->size);
+	memcpy(new_p, p, old_size);
 	free(p);
 	return new_p;
 }
 
 size_t heap_usage(void)
 {
-	unsigned int usage = 0;
-	chunk_t *head = (chunk_t *)&_heap_start;
-	while(head->next != NULL)
-	{
-		if(!head->free)
-			usage += head->size + sizeof(chunk_t);
-		head = head->next;
-	}
-	return usage;
+	return used;
 }
 
 void __heap_status(bool dump)
@@ -188,11 +450,29 @@ void __heap_status(bool dump)
 	size_t i;
 	unsigned int cntr;
 	unsigned int h_used, h_perc;
+	unsigned long h_free = 0, h_large = 0;
+	block_t *blk;
+
+	heap_lock();
 	h_used = heap_usage();
+	/* Fragmentation: share of free memory not usable as one block */
+	for(blk = first_block; blk && block_size(blk); blk = block_next(blk))
+	{
+		if(!block_is_free(blk))
+			continue;
+		h_free += block_size(blk);
+		if(block_size(blk) > h_large)
+			h_large = block_size(blk);
+	}
+	heap_unlock();
+
 	h_perc = (h_used * 100)/(unsigned int)&_heap_size;
 	printf("Heap Dump: %p - %p\n", &_heap_start, &_heap_end);
 	printf("Heap Used: %u/%u - %u%%\n", h_used,
 		(unsigned int)&_heap_size, h_perc);
+	printf("Heap Frag: %u%% (Largest free: %u/%u)\n",
+		h_free ? (unsigned int)(100 - ((h_large * 100) / h_free)) : 0,
+		(unsigned int)h_large, (unsigned int)h_free);
 
 	if(!dump)
 		return;
@@ -209,4 +489,3 @@ void __heap_status(bool dump)
 		printf("]\n");
 	}
 }
-
@@ -0,0 +1,87 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: mempool.c
+ * Description		: This file contains sources of fixed block
+ *			  memory pool allocator
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <status.h>
+#include <lock/lock.h>
+#include <arch.h>
+#include <mempool.h>
+
+static void pool_lock(mempool_t *pool, istate_t *state)
+{
+	/*
+	 * Irqs are masked before taking the key, else a preempting task
+	 * or ISR using same pool would spin on it forever on single core
+	 */
+	arch_di_save_state(state);
+	lock_acquire(&pool->key);
+}
+
+static void pool_unlock(mempool_t *pool, istate_t *state)
+{
+	lock_release(&pool->key);
+	arch_ei_restore_state(state);
+}
+
+bool mempool_owns(const mempool_t *pool, const void *p)
+{
+	size_t off = (size_t)p - (size_t)pool->base;
+	if((const uint8_t *)p < pool->base)
+		return false;
+	return (off < (pool->blk_size * pool->n_blks)) &&
+		!(off % pool->blk_size);
+}
+
+void *mempool_alloc(mempool_t *pool)
+{
+	istate_t state;
+	void *p = NULL;
+
+	if(!pool)
+		return NULL;
+
+	pool_lock(pool, &state);
+	if(pool->free_list)
+	{
+		p = pool->free_list;
+		pool->free_list = *(void **)p;
+	}
+	else if(pool->next < pool->n_blks)
+	{
+		p = pool->base + (pool->next * pool->blk_size);
+		pool->next++;
+	}
+	if(p)
+		pool->used++;
+	pool_unlock(pool, &state);
+	return p;
+}
+
+status_t mempool_free(mempool_t *pool, void *p)
+{
+	istate_t state;
+
+	if(!pool)
+		return error_func_inval_arg;
+	if(!p)
+		return success;
+	if(!mempool_owns(pool, p))
+		return error_inval_pointer;
+
+	pool_lock(pool, &state);
+	*(void **)p = pool->free_list;
+	pool->free_list = p;
+	pool->used--;
+	pool_unlock(pool, &state);
+	return success;
+}
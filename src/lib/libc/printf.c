@@ -29,23 +29,50 @@
 	((_lcount) == 1) ? va_arg(_args, unsigned long) :	\
 			    va_arg(_args, unsigned int))
 
-static int __fputc(const FILE *dev, bool en_stdout, const char c)
+/*
+ * Output of one call is collected in stack buffers, one for the
+ * target stream and one for stdout copy, and is passed to the
+ * stream in bulk when buffer fills up or the call returns.
+ */
+typedef struct pstream
+{
+	ccpdfs_buf_t dev;
+	ccpdfs_buf_t out;
+	bool en_stdout;
+} pstream_t;
+
+static void pstream_open(pstream_t *ps, const FILE *dev, bool en_stdout)
+{
+	ccpdfs_buf_init(&ps->dev, dev);
+	ccpdfs_buf_init(&ps->out, stdout);
+	ps->en_stdout = en_stdout;
+}
+
+static void pstream_close(pstream_t *ps)
+{
+	ccpdfs_buf_flush(&ps->dev);
+	if(ps->en_stdout)
+		ccpdfs_buf_flush(&ps->out);
+}
+
+static int __fputc(pstream_t *ps, const char c)
 {
 	int ret;
-	ret = ccpdfs_write(dev, c);
-	if(en_stdout)
-		ccpdfs_write(stdout, c);
+	const FILE *dev = ps->dev.dev;
+	ret = ccpdfs_buf_putc(&ps->dev, c);
+	if(ps->en_stdout)
+		ccpdfs_buf_putc(&ps->out, c);
 	if((c == '\n') && ((dev == stdout) || (dev == stdlog)))
-		__fputc(dev, en_stdout, '\r');
+		__fputc(ps, '\r');
 	return ret;
 }
 
-static int __fputs(const FILE *dev, bool en_stdout, const char *i)
+static int __fputs(pstream_t *ps, const char *i)
 {
 	int ret = 0;
 	while(*i != '\0')
 	{
-		__fputc(dev, en_stdout, *i);
+		__fputc(ps, *i);
 		ret++;
 		i++;
 	}
@@ -54,15 +81,30 @@ static int __fputs(const FILE *dev, bool en_stdout, const char *i)
 
 int fputc(const FILE *dev, const char c)
 {
-	return __fputc(dev, 0, c);
+	int ret;
+	pstream_t ps;
+	pstream_open(&ps, dev, false);
+	ret = __fputc(&ps, c);
+	pstream_close(&ps);
+	return ret;
 }
 
 int fputs(const FILE *dev, const char *i)
 {
-	return __fputs(dev, 0, i);
+	int ret;
+	pstream_t ps;
+	pstream_open(&ps, dev, false);
+	ret = __fputs(&ps, i);
+	pstream_close(&ps);
+	return ret;
 }
 
-static int unumprint(const FILE *dev, bool en_stdout, unsigned long unum,
+int fflush(const FILE *dev)
+{
+	return ccpdfs_flush(dev);
+}
+
+static int unumprint(pstream_t *ps, unsigned long unum,
 		unsigned int radix, char padc, int padn)
 {
 	char buf[20];
@@ -82,28 +124,28 @@ static int unumprint(const FILE *dev, bool en_stdout, unsigned long unum,
 	{
 		while(i < padn)
 		{
-			__fputc(dev, en_stdout, padc);
+			__fputc(ps, padc);
 			ret++;
 			padn--;
 		}
 	}
 	while(--i >= 0)
 	{
-		__fputc(dev, en_stdout, buf[i]);
+		__fputc(ps, buf[i]);
 		ret++;
 	}
 	return ret;
 }
 
 #if USE_FLOAT == 1
-static int fltprint(const FILE *dev, bool en_stdout, double flt,
+static int fltprint(pstream_t *ps, double flt,
 		char padc, int padd, int padf)
 {
 	int ret = 0;
 	long d = (long) flt;
 	double frac = flt - (double) d;
-	ret = unumprint(dev, en_stdout, d, 10, padc, padd);
-	__fputc(dev, en_stdout, '.');
+	ret = unumprint(ps, d, 10, padc, padd);
+	__fputc(ps, '.');
 	ret ++;
 	while(padf != 0)
 	{
@@ -111,9 +153,9 @@ static int fltprint(const FILE *dev, bool en_stdout, double flt,
 		padf--;
 		d = (long) frac;
 		if (!d)
-			__fputc(dev, en_stdout, '0');
+			__fputc(ps, '0');
 	}
-	ret += unumprint(dev, en_stdout, d,10, '0', 0);
+	ret += unumprint(ps, d,10, '0', 0);
 
 	return ret;
 }
@@ -133,6 +175,9 @@ int vprintf(const FILE *dev, bool en_stdout, const char *fmt, va_list args)
 	double flt;
 	int padf = 5;
 #endif
+	pstream_t stream, *ps = &stream;
+
+	pstream_open(ps, dev, en_stdout);
 
 	while(*fmt != '\0')
 	{
@@ -149,31 +194,31 @@ loop:
 					num = get_num_va_args(args, l_ret);
 					if (num < 0)
 					{
-						__fputc(dev, en_stdout, '-');
+						__fputc(ps, '-');
 						unum = (unsigned long)-num;
 						padn--;
 					}
 					else
 						unum = (unsigned long)num;
-					ret += unumprint(dev, en_stdout, unum, 10, padc, padn);
+					ret += unumprint(ps, unum, 10, padc, padn);
 					break;
 				case 'c':
 					str = va_arg(args, char *);
-					ret += __fputc(dev, en_stdout, (int)str);
+					ret += __fputc(ps, (int)str);
 					break;
 				case 's':
 					str = va_arg(args, char *);
-					ret += __fputs(dev, en_stdout, str);
+					ret += __fputs(ps, str);
 					break;
 				case 'p':
 					unum = (uintptr_t) va_arg(args, void *);
-					ret += __fputs(dev, en_stdout, "0x");
+					ret += __fputs(ps, "0x");
 					padn -= 2;
-					ret += unumprint(dev, en_stdout, unum, 16, padc, padn);
+					ret += unumprint(ps, unum, 16, padc, padn);
 					break;
 				case 'x':
 					unum = get_unum_va_args(args, l_ret);
-					ret += unumprint(dev, en_stdout, unum, 16, padc, padn);
+					ret += unumprint(ps, unum, 16, padc, padn);
 					break;
 				case 'z':
 					if (sizeof(size_t) == 8U)
@@ -187,18 +232,18 @@ loop:
 					goto loop;
 				case 'u':
 					unum = get_unum_va_args(args, l_ret);
-					ret += unumprint(dev, en_stdout, unum, 10, padc, padn);
+					ret += unumprint(ps, unum, 10, padc, padn);
 					break;
 #if USE_FLOAT == 1
 				case 'f':
 					flt = va_arg(args, double);
 					if(flt < 0)
 					{
-						__fputc(dev, en_stdout, '-');
+						__fputc(ps, '-');
 						flt *= -1.0;
 						padn--;
 					}
-					ret += fltprint(dev, en_stdout, flt, padc, padn, padf);
+					ret += fltprint(ps, flt, padc, padn, padf);
 					break;
 #endif
 				case '0':
@@ -227,19 +272,22 @@ loop:
 					}
 #endif
 				case '%':
-					ret += __fputc(dev, en_stdout, *fmt);
+					ret += __fputc(ps, *fmt);
 					break;
 				default:
-					return -1;
+					ret = -1;
+					goto exit;
 			}
 			fmt++;
 			continue;
 		}
 
-		__fputc(dev, en_stdout, (char)*fmt);
+		__fputc(ps, (char)*fmt);
 		fmt++;
 		ret++;
 	}
+exit:
+	pstream_close(ps);
 	return ret;
 }
 
@@ -46,3 +46,31 @@ status_t stdlog_register(status_t (*write)(const char))
 	stddev[3].write = write;
 	return success;
 }
+
+/*
+ * Bulk write and flush hooks are optional, write_buf is
+ * preferred over write when the stream is flushed.
+ */
+status_t stdout_register_buf(status_t (*write_buf)(const char *, size_t),
+		status_t (*flush)(void))
+{
+	stddev[1].write_buf = write_buf;
+	stddev[1].flush = flush;
+	return success;
+}
+
+status_t stderr_register_buf(status_t (*write_buf)(const char *, size_t),
+		status_t (*flush)(void))
+{
+	stddev[2].write_buf = write_buf;
+	stddev[2].flush = flush;
+	return success;
+}
+
+status_t stdlog_register_buf(status_t (*write_buf)(const char *, size_t),
+		status_t (*flush)(void))
+{
+	stddev[3].write_buf = write_buf;
+	stddev[3].flush = flush;
+	return success;
+}
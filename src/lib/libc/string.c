@@ -13,6 +13,28 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include <compiler_macros.h>
+
+/*
+ * Bulk of the memory functions work on machine words. Word access
+ * is done only when both pointers can be brought to word boundary
+ * together, else byte loop is used as misaligned access either traps
+ * or is slow on the supported cores. On 8/16-bit cores the word loops
+ * give no gain so only byte loops are built.
+ */
+#define WORD_OPS	(__SIZEOF_POINTER__ >= 4)
+
+typedef uintptr_t _ATTRIBUTE(__may_alias__) op_t;
+#define OPSIZ		(sizeof(op_t))
+#define OPMASK		(OPSIZ - 1)
+#define ONES		((op_t) -1 / 0xff)
+#define HIGHS		(ONES << 7)
+#define HAS_ZERO(x)	(((x) - ONES) & ~(x) & HIGHS)
+
+static inline bool co_aligned(const void *i, const void *j)
+{
+	return !(((uintptr_t)i ^ (uintptr_t)j) & OPMASK);
+}
 
 void *memchr(const void *i, int r, size_t n)
 {
@@ -31,6 +53,26 @@ int memcmp(const void *i, const void *j, size_t size)
 	int ret = 0;
 	const unsigned char *s = i;
 	const unsigned char *d = j;
+#if WORD_OPS
+	if(size >= OPSIZ && co_aligned(s, d))
+	{
+		while(((uintptr_t)s & OPMASK) && size)
+		{
+			ret = (*s++);
+			ret -= (*d++);
+			if(ret)
+				return ret;
+			size--;
+		}
+		/* Stop at first differing word, bytes decide the sign */
+		while(size >= OPSIZ && *(const op_t *)s == *(const op_t *)d)
+		{
+			s += OPSIZ;
+			d += OPSIZ;
+			size -= OPSIZ;
+		}
+	}
+#endif
 	while(size--)
 	{
 		ret = (*s++);
@@ -41,15 +83,46 @@ int memcmp(const void *i, const void *j, size_t size)
 	return ret;
 }
 
-void *memcpy(void *i, const void *j, size_t size)
+_WEAK void *memcpy(void *i, const void *j, size_t size)
 {
 	const char *src = j;
 	char *dst = i;
+#if WORD_OPS
+	if(size >= OPSIZ && co_aligned(src, dst))
+	{
+		op_t *wd;
+		const op_t *ws;
+		while((uintptr_t)dst & OPMASK)
+		{
+			*dst++ = *src++;
+			size--;
+		}
+		wd = (op_t *)dst;
+		ws = (const op_t *)src;
+		while(size >= (4 * OPSIZ))
+		{
+			wd[0] = ws[0];
+			wd[1] = ws[1];
+			wd[2] = ws[2];
+			wd[3] = ws[3];
+			wd += 4;
+			ws += 4;
+			size -= (4 * OPSIZ);
+		}
+		while(size >= OPSIZ)
+		{
+			*wd++ = *ws++;
+			size -= OPSIZ;
+		}
+		dst = (char *)wd;
+		src = (const char *)ws;
+	}
+#endif
 	while(size--)
 	{
 		*dst++ = *src++;
 	}
-	return dst;
+	return i;
 }
 
 void *memmove(void *i, const void *j, size_t size)
@@ -72,6 +145,27 @@ void *memmove(void *i, const void *j, size_t size)
 		const char *end = i;
 		const char *src = (const char *)j + size;
 		char *dst = (char *)i + size;
+#if WORD_OPS
+		if(size >= OPSIZ && co_aligned(src, dst))
+		{
+			op_t *wd;
+			const op_t *ws;
+			while((uintptr_t)dst & OPMASK)
+			{
+				*--dst = *--src;
+				size--;
+			}
+			wd = (op_t *)dst;
+			ws = (const op_t *)src;
+			while(size >= OPSIZ)
+			{
+				*--wd = *--ws;
+				size -= OPSIZ;
+			}
+			dst = (char *)wd;
+			src = (const char *)ws;
+		}
+#endif
 		while(dst != end)
 		{
 			*--dst = *--src;
@@ -92,9 +186,37 @@ void *memchr_rev(const void *i, int r, size_t n)
 	return NULL;
 }
 
-void *memset(void *i, int n, size_t size)
+_WEAK void *memset(void *i, int n, size_t size)
 {
 	char *p = i;
+#if WORD_OPS
+	if(size >= OPSIZ)
+	{
+		op_t *w;
+		op_t val = ONES * (unsigned char)n;
+		while((uintptr_t)p & OPMASK)
+		{
+			*p++ = n;
+			size--;
+		}
+		w = (op_t *)p;
+		while(size >= (4 * OPSIZ))
+		{
+			w[0] = val;
+			w[1] = val;
+			w[2] = val;
+			w[3] = val;
+			w += 4;
+			size -= (4 * OPSIZ);
+		}
+		while(size >= OPSIZ)
+		{
+			*w++ = val;
+			size -= OPSIZ;
+		}
+		p = (char *)w;
+	}
+#endif
 	while(size--)
 	{
 		*p++ = n;
@@ -153,6 +275,20 @@ size_t strlcpy(char *i, const char *j, size_t size)
 size_t strlen(const char *i)
 {
 	const char *p = i;
+#if WORD_OPS
+	const op_t *w;
+	/* Aligned word never crosses into unmapped memory */
+	while((uintptr_t)p & OPMASK)
+	{
+		if(!*p)
+			return (p - i);
+		p++;
+	}
+	w = (const op_t *)p;
+	while(!HAS_ZERO(*w))
+		w++;
+	p = (const char *)w;
+#endif
 	while(*p)
 		p++;
 	return (p - i);
@@ -16,5 +16,9 @@ LIB		:= libccfs.a
 LIB_INCLUDE	+= $(LIBCCFS_PATH)/include/
 DEP_LIBS_ARG	+= -lccfs
 
+# Size of stack buffer used to batch printf output per stream
+CCPDFS_BUF_SIZE	?= 32
+$(eval $(call add_define,CCPDFS_BUF_SIZE))
+
 DIR		:= $(LIBCCFS_PATH)
 include mk/lib.mk
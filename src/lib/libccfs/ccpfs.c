@@ -9,6 +9,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <assert.h>
 #include <status.h>
 #include <ccpfs.h>
@@ -21,6 +22,19 @@ status_t ccpdfs_write(const ccpdfs_t *dev, const char c)
 	return dev->write(c);
 }
 
+status_t ccpdfs_write_buf(const ccpdfs_t *dev, const char *buf, size_t len)
+{
+	status_t ret = success;
+	assert(dev);
+	if(dev->write_buf)
+		return dev->write_buf(buf, len);
+	if(!dev->write)
+		return error_file_io;
+	while(len--)
+		ret |= dev->write(*buf++);
+	return ret;
+}
+
 status_t ccpdfs_read(const ccpdfs_t *dev, char *c)
 {
 	assert(dev);
@@ -28,3 +42,40 @@ status_t ccpdfs_read(const ccpdfs_t *dev, char *c)
 		return error_file_io;
 	return dev->read(c);
 }
+
+status_t ccpdfs_flush(const ccpdfs_t *dev)
+{
+	assert(dev);
+	if(!dev->flush)
+		return success;
+	return dev->flush();
+}
+
+void ccpdfs_buf_init(ccpdfs_buf_t *buf, const ccpdfs_t *dev)
+{
+	assert(buf);
+	buf->dev = dev;
+	buf->len = 0;
+}
+
+status_t ccpdfs_buf_putc(ccpdfs_buf_t *buf, const char c)
+{
+	status_t ret = success;
+	assert(buf && buf->dev);
+	if(!buf->dev->write && !buf->dev->write_buf)
+		return error_file_io;
+	if(buf->len == CCPDFS_BUF_SIZE)
+		ret = ccpdfs_buf_flush(buf);
+	buf->data[buf->len++] = c;
+	return ret;
+}
+
+status_t ccpdfs_buf_flush(ccpdfs_buf_t *buf)
+{
+	status_t ret = success;
+	assert(buf && buf->dev);
+	if(buf->len)
+		ret = ccpdfs_write_buf(buf->dev, buf->data, buf->len);
+	buf->len = 0;
+	return ret;
+}
@@ -12,11 +12,35 @@
 #pragma once
 #define _CCPFS_H_
 
+#include <stddef.h>
+
 typedef struct ccpdfs
 {
 	status_t (*write)(const char);
 	status_t (*read)(char *);
+	status_t (*write_buf)(const char *, size_t);
+	status_t (*flush)(void);
 } ccpdfs_t;
 
+/*
+ * ccpdfs_buf_t - Output batching buffer
+ * Writers collect data in this buffer which is handed over to the
+ * device in one write_buf call when it gets full or is flushed.
+ * Buffer is owned by the writer (usually on its stack) so that
+ * writers from different contexts do not need a common lock.
+ */
+typedef struct ccpdfs_buf
+{
+	const ccpdfs_t *dev;
+	size_t len;
+	char data[CCPDFS_BUF_SIZE];
+} ccpdfs_buf_t;
+
 status_t ccpdfs_write(const ccpdfs_t *, const char);
+status_t ccpdfs_write_buf(const ccpdfs_t *, const char *, size_t);
 status_t ccpdfs_read(const ccpdfs_t *, char *);
+status_t ccpdfs_flush(const ccpdfs_t *);
+
+void ccpdfs_buf_init(ccpdfs_buf_t *, const ccpdfs_t *);
+status_t ccpdfs_buf_putc(ccpdfs_buf_t *, const char);
+status_t ccpdfs_buf_flush(ccpdfs_buf_t *);
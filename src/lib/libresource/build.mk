@@ -16,6 +16,11 @@ LIB		:= libresource.a
 LIB_INCLUDE	+= $(DP_PATH)/include/
 DEP_LIBS_ARG	+= -lresource
 
+# Slots in each property lookup index, must be power of 2 and
+# larger than number of modules/ports/software devices
+RES_INDEX_SIZE	?= 16
+$(eval $(call add_define,RES_INDEX_SIZE))
+
 include $(DP_PATH)/dp/build.mk
 include $(DP_PATH)/sp/build.mk
 
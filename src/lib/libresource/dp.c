@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <status.h>
 #include <resource.h>
+#include <res_index.h>
 
 /**
  * *dev_prop - A pointer to device properties
@@ -20,6 +21,26 @@
  */
 dp_t *dev_prop;
 
+/**
+ * dp_mod_index, dp_port_index - Lookup index of modules and ports
+ *
+ * @brief These are built by dp_init so that module and port
+ * info is fetched without scanning the lists.
+ */
+res_index_t dp_mod_index;
+res_index_t dp_port_index;
+
+static void dp_build_index(void)
+{
+	size_t i;
+	res_index_reset(&dp_mod_index, dev_prop->n_mods);
+	for(i = 0; i < dev_prop->n_mods; i++)
+		res_index_add(&dp_mod_index, dev_prop->modules[i]->id, i);
+	res_index_reset(&dp_port_index, dev_prop->n_ports);
+	for(i = 0; i < dev_prop->n_ports; i++)
+		res_index_add(&dp_port_index, dev_prop->ports[i]->id, i);
+}
+
 /**
  * dp_init - Device properties init
  *
@@ -40,6 +61,7 @@ status_t dp_init(dp_t *plat_dev_prop)
 	{
 		/* Link the pointer and return success */
 		dev_prop = plat_dev_prop;
+		dp_build_index();
 		ret = success;
 	}
 	else
@@ -12,9 +12,11 @@
 #include <stddef.h>
 #include <status.h>
 #include <resource.h>
+#include <res_index.h>
 
 /* Refer dp.c file for info */
 extern dp_t *dev_prop;
+extern res_index_t dp_port_index;
 
 /**
  * *dp_get_port_into - Get GPIO port info
@@ -33,6 +35,16 @@ extern dp_t *dev_prop;
 gpio_module_t *dp_get_port_info(hw_devid_t id)
 {
 	unsigned int i, n_ports;
+	uint8_t pos;
+	if(dp_port_index.valid)
+	{
+		for(i = res_hash(id); (pos = dp_port_index.slot[i]); i = res_index_next(i))
+		{
+			if(dev_prop->ports[pos - 1]->id == id)
+				return dev_prop->ports[pos - 1];
+		}
+		return NULL;
+	}
 	n_ports = dev_prop->n_ports;
 	for(i = 0; i < n_ports; i++)
 	{
@@ -12,9 +12,11 @@
 #include <stddef.h>
 #include <status.h>
 #include <resource.h>
+#include <res_index.h>
 
 /* Refer dp.c file for info */
 extern dp_t *dev_prop;
+extern res_index_t dp_mod_index;
 
 /**
  * *dp_get_module_info - get the module info
@@ -24,6 +26,16 @@ extern dp_t *dev_prop;
 module_t *dp_get_module_info(hw_devid_t dev)
 {
 	unsigned int i, n_mods;
+	uint8_t pos;
+	if(dp_mod_index.valid)
+	{
+		for(i = res_hash(dev); (pos = dp_mod_index.slot[i]); i = res_index_next(i))
+		{
+			if(dev_prop->modules[pos - 1]->id == dev)
+				return dev_prop->modules[pos - 1];
+		}
+		return NULL;
+	}
 	n_mods = dev_prop->n_mods;
 	for(i = 0; i < n_mods; i++)
 	{
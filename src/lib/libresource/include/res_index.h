@@ -0,0 +1,52 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: res_index.h
+ * Description		: This file contains prototypes of resource
+ *			  lookup index
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#pragma once
+#define _RES_INDEX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define RES_INDEX_MASK	(RES_INDEX_SIZE - 1)
+
+#if (RES_INDEX_SIZE & RES_INDEX_MASK) || (RES_INDEX_SIZE > 256)
+#error "RES_INDEX_SIZE must be a power of 2, at most 256"
+#endif
+
+/*
+ * res_index_t - Hash index over a property list
+ * Slot holds position of entry in list + 1, 0 marks empty slot.
+ * Collisions are resolved by linear probing. Index is marked valid
+ * only if all entries fit leaving at least one empty slot, else
+ * lookups fall back to scanning the list.
+ */
+typedef struct res_index
+{
+	uint8_t slot[RES_INDEX_SIZE];
+	bool valid;
+} res_index_t;
+
+/*
+ * IDs carry class, sub-class and instance in separate nibbles,
+ * folding all nibbles keeps them apart in the index.
+ */
+static inline unsigned int res_hash(unsigned int id)
+{
+	id ^= id >> 8;
+	id ^= id >> 4;
+	return id & RES_INDEX_MASK;
+}
+
+#define res_index_next(h)	(((h) + 1) & RES_INDEX_MASK)
+
+void res_index_reset(res_index_t *, size_t);
+void res_index_add(res_index_t *, unsigned int, size_t);
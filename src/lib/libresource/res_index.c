@@ -0,0 +1,50 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: res_index.c
+ * Description		: This file contains sources of resource
+ *			  lookup index
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <res_index.h>
+
+/**
+ * res_index_reset - Clears the index
+ *
+ * @param[in] *idx: index to be cleared
+ * @param[in] n_entries: number of entries going to be added
+ */
+void res_index_reset(res_index_t *idx, size_t n_entries)
+{
+	unsigned int i;
+	for(i = 0; i < RES_INDEX_SIZE; i++)
+		idx->slot[i] = 0;
+	idx->valid = (n_entries < RES_INDEX_SIZE);
+}
+
+/**
+ * res_index_add - Adds an entry to index
+ *
+ * @brief Entries with same ID end up later in probe chain,
+ * so lookup returns the first one added, as list scan did.
+ *
+ * @param[in] *idx: index
+ * @param[in] id: ID of the entry
+ * @param[in] pos: position of the entry in list
+ */
+void res_index_add(res_index_t *idx, unsigned int id, size_t pos)
+{
+	unsigned int h;
+	if(!idx->valid)
+		return;
+	h = res_hash(id);
+	while(idx->slot[h])
+		h = res_index_next(h);
+	idx->slot[h] = (uint8_t)(pos + 1);
+}
@@ -10,6 +10,7 @@
 
 #include <status.h>
 #include <sp.h>
+#include <res_index.h>
 
 /**
  * *sw_prop - A pointer to software properties
@@ -19,6 +20,39 @@
  */
 sp_t *sw_prop;
 
+/**
+ * sp_swdev_index, sp_terra_index - Lookup index of software devices
+ *
+ * @brief sp_swdev_index covers all software devices, sp_terra_index
+ * covers only the devices listed for terravisor so that ownership
+ * check and lookup is a single probe.
+ */
+res_index_t sp_swdev_index;
+res_index_t sp_terra_index;
+
+static void sp_build_index(void)
+{
+	size_t i, j;
+	visor_t *terra = sw_prop->terravisor;
+
+	res_index_reset(&sp_swdev_index, sw_prop->n_swdev);
+	for(j = 0; j < sw_prop->n_swdev; j++)
+		res_index_add(&sp_swdev_index, sw_prop->swdev[j]->swdev_id, j);
+
+	res_index_reset(&sp_terra_index, terra->n_dev);
+	for(i = 0; i < terra->n_dev; i++)
+	{
+		for(j = 0; j < sw_prop->n_swdev; j++)
+		{
+			if(terra->devids[i] == sw_prop->swdev[j]->swdev_id)
+			{
+				res_index_add(&sp_terra_index, terra->devids[i], j);
+				break;
+			}
+		}
+	}
+}
+
 /**
  * sp_init - Software properties init
  *
@@ -39,6 +73,7 @@ status_t sp_init(sp_t *plat_sw_prop)
 	{
 		/* Link the pointer and return success */
 		sw_prop = plat_sw_prop;
+		sp_build_index();
 		ret = success;
 	}
 	else
@@ -1,106 +1,82 @@
+#include <stdint.h>
+#include <status.h>
 #include <sp.h>
+#include <res_index.h>
 
 extern sp_t *sw_prop;
+extern res_index_t sp_swdev_index;
+extern res_index_t sp_terra_index;
 
-swdev_t *sp_terravisor_dev_info(sw_devid_t devid)
+static swdev_t *sp_index_find(const res_index_t *idx, sw_devid_t devid)
 {
-	unsigned int i, j, n_devs, n_swdevs;
-	n_devs = sw_prop->terravisor->n_dev;
-	n_swdevs = sw_prop->n_swdev;
-	for(i = 0; i < n_devs; i++)
+	unsigned int h;
+	uint8_t pos;
+	for(h = res_hash(devid); (pos = idx->slot[h]); h = res_index_next(h))
 	{
-		if(devid == sw_prop->terravisor->devids[i])
-		{
-			for(j = 0; j < n_swdevs; j++)
-			{
-				if(devid == sw_prop->swdev[j]->swdev_id)
-					return sw_prop->swdev[j];
-			}
-		}
+		if(devid == sw_prop->swdev[pos - 1]->swdev_id)
+			return sw_prop->swdev[pos - 1];
 	}
 	return 0;
 }
 
-#if NSEC_HYP == 1
-swdev_t *sp_nsec_hypervisor_dev_into(sw_devid_t devid)
+static swdev_t *sp_swdev_find(sw_devid_t devid)
 {
-	unsigned int i, j, n_devs, n_swdevs;
-	n_devs = sw_prop->nsec_hypervisor->n_dev;
+	unsigned int j, n_swdevs;
+	if(sp_swdev_index.valid)
+		return sp_index_find(&sp_swdev_index, devid);
 	n_swdevs = sw_prop->n_swdev;
-	for(i = 0; i < n_devs; i++)
+	for(j = 0; j < n_swdevs; j++)
 	{
-		if(devid == sw_prop->nsec_hypervisor->devids[i])
-		{
-			for(j = 0; j < n_swdevs; j++)
-			{
-				if(devid == sw_prop->swdev[j]->swdev_id)
-					return sw_prop->swdev[j];
-			}
-		}
+		if(devid == sw_prop->swdev[j]->swdev_id)
+			return sw_prop->swdev[j];
 	}
 	return 0;
 }
-#endif
 
-#if SEC_HYP == 1
-swdev_t *sp_sec_hypervisor_dev_info(sw_devid_t devid)
+/* Returns software device only if it is assigned to the visor */
+static swdev_t *sp_visor_dev_info(visor_t *visor, sw_devid_t devid)
 {
-	unsigned int i, j, n_devs, n_swdevs;
-	n_devs = sw_prop->sec_hypervisor->n_dev;
-	n_swdevs = sw_prop->n_swdev;
+	unsigned int i, n_devs;
+	n_devs = visor->n_dev;
 	for(i = 0; i < n_devs; i++)
 	{
-		if(devid == sw_prop->sec_hypervisor->devids[i])
-		{
-			for(j = 0; j < n_swdevs; j++)
-			{
-				if(devid == sw_prop->swdev[j]->swdev_id)
-					return sw_prop->swdev[j];
-			}
-		}
+		if(devid == visor->devids[i])
+			return sp_swdev_find(devid);
 	}
 	return 0;
 }
+
+swdev_t *sp_terravisor_dev_info(sw_devid_t devid)
+{
+	if(sp_terra_index.valid)
+		return sp_index_find(&sp_terra_index, devid);
+	return sp_visor_dev_info(sw_prop->terravisor, devid);
+}
+
+#if NSEC_HYP == 1
+swdev_t *sp_nsec_hypervisor_dev_into(sw_devid_t devid)
+{
+	return sp_visor_dev_info(sw_prop->nsec_hypervisor, devid);
+}
+#endif
+
+#if SEC_HYP == 1
+swdev_t *sp_sec_hypervisor_dev_info(sw_devid_t devid)
+{
+	return sp_visor_dev_info(sw_prop->sec_hypervisor, devid);
+}
 #endif
 
 #if NSEC_SUP >= 1
 swdev_t *sp_nsec_supervisor_dev_info(size_t index, sw_devid_t devid)
 {
-	unsigned int i, j, n_devs, n_swdevs;
-	n_devs = sw_prop->nsec_supervisor[index]->n_dev;
-	n_swdevs = sw_prop->n_swdev;
-	for(i = 0; i < n_devs; i++)
-	{
-		if(devid == sw_prop->nsec_supervisor[index]->devids[i])
-		{
-			for(j = 0; j < n_swdevs; j++)
-			{
-				if(devid == sw_prop->swdev[j]->swdev_id)
-					return sw_prop->swdev[j];
-			}
-		}
-	}
-	return 0;
+	return sp_visor_dev_info(sw_prop->nsec_supervisor[index], devid);
 }
 #endif
 
 #if SEC_SUP >= 1
 swdev_t *sp_sec_supervisor_dev_info(size_t index, sw_devid_t devid)
 {
-	unsigned int i, j, n_devs, n_swdevs;
-	n_devs = sw_prop->sec_supervisor[index]->n_dev;
-	n_swdevs = sw_prop->n_swdev;
-	for(i = 0; i < n_devs; i++)
-	{
-		if(devid == sw_prop->sec_supervisor[index]->devids[i])
-		{
-			for(j = 0; j < n_swdevs; j++)
-			{
-				if(devid == sw_prop->swdev[j]->swdev_id)
-					return sw_prop->swdev[j];
-			}
-		}
-	}
-	return 0;
+	return sp_visor_dev_info(sw_prop->sec_supervisor[index], devid);
 }
 #endif
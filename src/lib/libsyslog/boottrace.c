@@ -0,0 +1,79 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: boottrace.c
+ * Description		: This file is the source for boot time trace
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <status.h>
+#include <arch.h>
+#include <lock/lock.h>
+#include <syslog.h>
+#include <boottrace.h>
+
+#if BOOT_TRACE
+
+#ifndef ARCH_CYCLES_MASK
+#error < ! > Boot trace needs arch_read_cycles support from arch!
+#endif
+
+boottrace_rec_t boottrace_rec[BOOT_TRACE_SIZE];
+unsigned int boottrace_count;
+static unsigned long bt_last_raw, bt_ticks;
+static lock_t bt_lock;
+
+/**
+ * boottrace_mark_at - Records timestamp for a boot stage
+ *
+ * @brief Counter delta since last mark is accumulated, so that
+ * narrow arch counters (16 bit on AVR) are extended as long as
+ * stages are shorter than one counter wrap. Marks beyond
+ * BOOT_TRACE_SIZE are dropped.
+ *
+ * @param[in] tag: Name of stage, must be a static string
+ * @param[in] stamp: arch_read_cycles() value at the stage
+ */
+void boottrace_mark_at(const char *tag, unsigned long stamp)
+{
+	lock_acquire(&bt_lock);
+	if(boottrace_count)
+		bt_ticks += (stamp - bt_last_raw) & ARCH_CYCLES_MASK;
+	else
+		bt_ticks = stamp;
+	bt_last_raw = stamp;
+
+	if(boottrace_count < BOOT_TRACE_SIZE)
+	{
+		boottrace_rec[boottrace_count].tag = tag;
+		boottrace_rec[boottrace_count].ticks = bt_ticks;
+		boottrace_count++;
+	}
+	lock_release(&bt_lock);
+}
+
+/**
+ * boottrace_dump - Prints boot trace records via syslog
+ *
+ * @brief Each line carries the tag, ticks at the mark and ticks
+ * spent since previous mark. Lines land in stdlog, so a host tool
+ * can read them back from membuf as well.
+ */
+void boottrace_dump(void)
+{
+	unsigned long prev = 0;
+	syslog(info, "Boot trace (1 tick = %u cycles)\n", ARCH_CYCLES_DIV);
+	for(unsigned int i = 0; i < boottrace_count; i++)
+	{
+		syslog(info, "boot: %s @ %lu (+%lu)\n", boottrace_rec[i].tag,
+			boottrace_rec[i].ticks,
+			i ? (boottrace_rec[i].ticks - prev) : 0UL);
+		prev = boottrace_rec[i].ticks;
+	}
+}
+
+#endif
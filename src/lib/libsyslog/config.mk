@@ -19,3 +19,20 @@ $(eval $(call add_define,SYSLOG_BUFFER_LEN))
 
 SYSLOG_COLORED_LOG		?= 0
 $(eval $(call add_define,SYSLOG_COLORED_LOG))
+
+# Record timestamps of boot stages and driver setup
+BOOT_TRACE			?= 0
+$(eval $(call add_define,BOOT_TRACE))
+
+BOOT_TRACE_SIZE			?= 24
+$(eval $(call add_define,BOOT_TRACE_SIZE))
+
+# Per irq counters and latency/duration histograms
+IRQ_STATS			?= 0
+$(eval $(call add_define,IRQ_STATS))
+
+IRQ_STATS_SLOTS			?= 8
+$(eval $(call add_define,IRQ_STATS_SLOTS))
+
+IRQ_STATS_BUCKETS		?= 8
+$(eval $(call add_define,IRQ_STATS_BUCKETS))
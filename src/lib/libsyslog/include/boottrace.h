@@ -0,0 +1,54 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: boottrace.h
+ * Description		: This file defines the prototypes for boot
+ *			  time trace
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#pragma once
+#define _BOOTTRACE_H_
+
+#include <compiler_macros.h>
+#include <arch.h>
+
+typedef struct boottrace_rec
+{
+	const char *tag;
+	unsigned long ticks;
+} boottrace_rec_t;
+
+#if BOOT_TRACE
+/*
+ * Records are kept in boottrace_rec[0..boottrace_count), ticks
+ * are arch_read_cycles() counts since the first mark extended
+ * to unsigned long, multiply by ARCH_CYCLES_DIV to get cycles.
+ */
+extern boottrace_rec_t boottrace_rec[];
+extern unsigned int boottrace_count;
+
+void boottrace_mark_at(const char *tag, unsigned long stamp);
+void boottrace_dump(void);
+
+/*
+ * boottrace_stamp - Takes a raw stamp, to be recorded later with
+ * boottrace_mark_at, needed before .data/.bss are initialised
+ */
+static inline unsigned long boottrace_stamp(void)
+{
+	return arch_read_cycles();
+}
+
+static inline void boottrace_mark(const char *tag)
+{
+	boottrace_mark_at(tag, arch_read_cycles());
+}
+#else
+static inline unsigned long boottrace_stamp(void) { return 0; }
+static inline void boottrace_mark_at(const char *tag _UNUSED, unsigned long stamp _UNUSED) {}
+static inline void boottrace_mark(const char *tag _UNUSED) {}
+static inline void boottrace_dump(void) {}
+#endif
@@ -0,0 +1,62 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: irqstat.h
+ * Description		: This file defines the prototypes for per irq
+ *			  statistics
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#pragma once
+#define _IRQSTAT_H_
+
+#include <stdint.h>
+#include <compiler_macros.h>
+#include <arch.h>
+
+typedef struct irqstat
+{
+	uint16_t key;
+	unsigned long count;
+	unsigned long lat_max;
+	unsigned long dur_max;
+	uint16_t lat_hist[IRQ_STATS_BUCKETS];
+	uint16_t dur_hist[IRQ_STATS_BUCKETS];
+} irqstat_t;
+
+#if IRQ_STATS
+/*
+ * Times are arch_read_cycles() ticks (ARCH_CYCLES_DIV cycles each).
+ * Latency is from trap entry to start of handler, so for sources
+ * serviced in a loop it includes handlers run before it. Histogram
+ * bucket 0 counts 0 ticks and bucket n counts [2^(n-1), 2^n) ticks,
+ * last bucket takes everything above. Bucket counters saturate.
+ */
+unsigned long irqstat_trap_enter(void);
+void irqstat_trap_exit(unsigned long prev);
+unsigned long irqstat_trap_stamp(void);
+void irqstat_record(unsigned int module, unsigned int id,
+		unsigned long t_entry, unsigned long t_start, unsigned long t_end);
+const irqstat_t *irqstat_get(unsigned int core, unsigned int module, unsigned int id);
+void irqstat_reset(void);
+void irqstat_dump(void);
+
+static inline unsigned long irqstat_stamp(void)
+{
+	return arch_read_cycles();
+}
+#else
+static inline unsigned long irqstat_trap_enter(void) { return 0; }
+static inline void irqstat_trap_exit(unsigned long prev _UNUSED) {}
+static inline unsigned long irqstat_trap_stamp(void) { return 0; }
+static inline void irqstat_record(unsigned int module _UNUSED, unsigned int id _UNUSED,
+		unsigned long t_entry _UNUSED, unsigned long t_start _UNUSED,
+		unsigned long t_end _UNUSED) {}
+static inline const irqstat_t *irqstat_get(unsigned int core _UNUSED,
+		unsigned int module _UNUSED, unsigned int id _UNUSED) { return NULL; }
+static inline void irqstat_reset(void) {}
+static inline void irqstat_dump(void) {}
+static inline unsigned long irqstat_stamp(void) { return 0; }
+#endif
@@ -0,0 +1,199 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: irqstat.c
+ * Description		: This file is the source for per irq statistics
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <status.h>
+#include <string.h>
+#include <arch.h>
+#include <syslog.h>
+#include <irqstat.h>
+
+#if IRQ_STATS
+
+#ifndef ARCH_CYCLES_MASK
+#error < ! > IRQ stats needs arch_read_cycles support from arch!
+#endif
+
+#define IRQSTAT_KEY(module, id)	(uint16_t)((((module) & 0xf) << 12) | ((id) & 0xfff))
+
+/*
+ * Tables are per core and only written by the owning core with local
+ * irqs masked, so no lock is needed. Slots are claimed on first fire
+ * of an irq, irqs beyond IRQ_STATS_SLOTS are not accounted.
+ */
+static irqstat_t irqstat_tbl[N_CORES][IRQ_STATS_SLOTS];
+static unsigned long irqstat_entry[N_CORES];
+
+static irqstat_t *irqstat_slot(unsigned int core, uint16_t key, bool claim)
+{
+	irqstat_t *s;
+	unsigned int i, h = key % IRQ_STATS_SLOTS;
+
+	for(i = 0; i < IRQ_STATS_SLOTS; i++)
+	{
+		s = &irqstat_tbl[core][h];
+		if(s->key == key)
+			return s;
+		if(!s->key)
+		{
+			if(!claim)
+				return NULL;
+			s->key = key;
+			return s;
+		}
+		h = (h + 1) % IRQ_STATS_SLOTS;
+	}
+	return NULL;
+}
+
+static void irqstat_hist(uint16_t *hist, unsigned long ticks)
+{
+	unsigned int b = 0;
+	while(ticks && b < (IRQ_STATS_BUCKETS - 1))
+	{
+		ticks >>= 1;
+		b++;
+	}
+	if(hist[b] != UINT16_MAX)
+		hist[b]++;
+}
+
+/**
+ * irqstat_trap_enter - Stamps entry of trap
+ *
+ * @brief Called first thing in arch trap handler. Stamp is kept per
+ * core for controller drivers which dispatch irqs within the trap.
+ *
+ * @return prev: Stamp of the trap being preempted, to be passed to
+ * irqstat_trap_exit when nesting is possible
+ */
+unsigned long irqstat_trap_enter(void)
+{
+	unsigned int core = arch_core_index();
+	unsigned long prev = irqstat_entry[core];
+	irqstat_entry[core] = arch_read_cycles();
+	return prev;
+}
+
+void irqstat_trap_exit(unsigned long prev)
+{
+	irqstat_entry[arch_core_index()] = prev;
+}
+
+/**
+ * irqstat_trap_stamp - Returns entry stamp of current trap
+ */
+unsigned long irqstat_trap_stamp(void)
+{
+	return irqstat_entry[arch_core_index()];
+}
+
+/**
+ * irqstat_record - Accounts one execution of an irq handler
+ *
+ * @param[in] module: int_module_t of the irq
+ * @param[in] id: irq id within the module
+ * @param[in] t_entry: stamp at trap entry
+ * @param[in] t_start: stamp before calling handler
+ * @param[in] t_end: stamp after handler returned
+ */
+void irqstat_record(unsigned int module, unsigned int id,
+		unsigned long t_entry, unsigned long t_start, unsigned long t_end)
+{
+	istate_t ist;
+	irqstat_t *s;
+	unsigned long lat, dur;
+
+	lat = (t_start - t_entry) & ARCH_CYCLES_MASK;
+	dur = (t_end - t_start) & ARCH_CYCLES_MASK;
+
+	arch_di_save_state(&ist);
+	s = irqstat_slot(arch_core_index(), IRQSTAT_KEY(module, id), true);
+	if(s)
+	{
+		s->count++;
+		if(lat > s->lat_max)
+			s->lat_max = lat;
+		if(dur > s->dur_max)
+			s->dur_max = dur;
+		irqstat_hist(s->lat_hist, lat);
+		irqstat_hist(s->dur_hist, dur);
+	}
+	arch_ei_restore_state(&ist);
+}
+
+/**
+ * irqstat_get - Query statistics of an irq
+ *
+ * @param[in] core: core which serviced the irq
+ * @param[in] module: int_module_t of the irq
+ * @param[in] id: irq id within the module
+ *
+ * @return stat: NULL if irq has not fired on the core
+ */
+const irqstat_t *irqstat_get(unsigned int core, unsigned int module, unsigned int id)
+{
+	if(core >= N_CORES)
+		return NULL;
+	return irqstat_slot(core, IRQSTAT_KEY(module, id), false);
+}
+
+/**
+ * irqstat_reset - Clears statistics of all cores
+ */
+void irqstat_reset(void)
+{
+	istate_t ist;
+	arch_di_save_state(&ist);
+	memset(irqstat_tbl, 0, sizeof(irqstat_tbl));
+	arch_ei_restore_state(&ist);
+}
+
+/* Only non-empty buckets are printed, one per line, as "<2^b" ticks */
+static void irqstat_dump_hist(const char *name, const uint16_t *hist)
+{
+	for(unsigned int b = 0; b < IRQ_STATS_BUCKETS; b++)
+	{
+		if(!hist[b])
+			continue;
+		if(b == IRQ_STATS_BUCKETS - 1)
+			syslog(info, "irq:   %s >=%lu: %u\n", name,
+				b ? (1UL << (b - 1)) : 0UL, hist[b]);
+		else
+			syslog(info, "irq:   %s <%lu: %u\n", name, 1UL << b, hist[b]);
+	}
+}
+
+/**
+ * irqstat_dump - Prints statistics of all cores via syslog
+ */
+void irqstat_dump(void)
+{
+	const irqstat_t *s;
+	syslog(info, "IRQ stats (1 tick = %u cycles)\n", ARCH_CYCLES_DIV);
+	for(unsigned int c = 0; c < N_CORES; c++)
+	{
+		for(unsigned int i = 0; i < IRQ_STATS_SLOTS; i++)
+		{
+			s = &irqstat_tbl[c][i];
+			if(!s->key)
+				continue;
+			syslog(info, "irq: core%u m%u#%u n=%lu lat<=%lu dur<=%lu\n",
+				c, s->key >> 12, s->key & 0xfff, s->count,
+				s->lat_max, s->dur_max);
+			irqstat_dump_hist("lat", s->lat_hist);
+			irqstat_dump_hist("dur", s->dur_hist);
+		}
+	}
+}
+
+#endif
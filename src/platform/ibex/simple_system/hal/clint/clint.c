@@ -14,6 +14,7 @@
 #include <assert.h>
 #include <arch.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <resource.h>
 #include <hal/clint.h>
 #include <driver.h>
@@ -28,7 +29,7 @@ static status_t clint_setup()
 	vret_t vres;
 	const module_t *dp;
 
-	arch_visor_call(fetch_dp, clint, 0, 0, &vres);
+	devprop_fetch_dp(clint, 0, &vres);
 
 	if(vres.status != success)
 		return vres.status;
@@ -14,6 +14,7 @@
 #include <syslog.h>
 #include <arch.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <resource.h>
 #include <mmio.h>
 #include <hal/uart.h>
@@ -26,7 +27,7 @@ status_t uart_get_properties(uart_port_t *port, sw_devid_t dev)
 	module_t *dp;
 	hw_devid_t devid;
 
-	arch_visor_call(fetch_sp, dev, 0, 0, &vres);
+	devprop_fetch_sp(dev, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("%p - sp node could not be found!\n", dev);
@@ -36,7 +37,7 @@ status_t uart_get_properties(uart_port_t *port, sw_devid_t dev)
 	devid = sp->hwdev_id;
 	port->pmux = sp->pmux;
 
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0xff), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0xff), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("UART Device %d not found!\n", devid);
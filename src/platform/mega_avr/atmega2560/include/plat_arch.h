@@ -29,6 +29,9 @@
 #define SREG		0x3f
 #define SMCR		0x53
 #define WDTCSR		0x60
+#define TCCR1A		0x80
+#define TCCR1B		0x81
+#define TCNT1		0x84
 #define CLKPR		0x61
 #define PRR0		0x64
 #define PRR1		0x65
@@ -30,6 +30,12 @@ RAM_START	:= 0x00800100
 RAM_SIZE	:= 0x800	# 2K
 HEAP_SIZE	?= 256
 STACK_SIZE	?= 256
+# Keep malloc free lists small for tiny heap
+HEAP_SL_LOG2	?= 0
+# Keep printf stack buffers small
+CCPDFS_BUF_SIZE	?= 16
+# Keep driver property cache small
+DEVPROP_CACHE_SIZE	?= 4
 
 $(eval $(call add_define,HEAP_SIZE))
 $(eval $(call add_define,STACK_SIZE))
@@ -17,6 +17,7 @@
 #include <mmio.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include <lock/lock.h>
 #include <hal/gpio.h>
@@ -58,7 +59,7 @@ status_t gpio_pin_alloc(gpio_port_t *port, uint8_t portID, uint8_t pinID)
 
 	port->pin = pinID;
 	port->port = portID;
-	arch_visor_call(fetch_dp, gpio, portID, 0, &vres);
+	devprop_fetch_dp(gpio, portID, &vres);
 	if(vres.status != success)
 	{
 		sysdbg4("GPIO Port %d not found in DP\n", portID);
@@ -71,6 +72,64 @@ status_t gpio_pin_alloc(gpio_port_t *port, uint8_t portID, uint8_t pinID)
 	return success;
 }
 
+/**
+ * gpio_pmux_alloc - Allocates all the GPIO pins of pinmux
+ *
+ * @brief Allocates pins of pinmux together, port properties
+ * are looked up once for all the pins
+ *
+ * @param[out] port: Array of GPIO port structure, one per pin
+ * @param[in] pmux: Pinmux node from software properties
+ *
+ * @return status: Status of allocation operation
+ */
+
+status_t gpio_pmux_alloc(gpio_port_t *port, pinmux_t *pmux)
+{
+	vret_t vres;
+	gpio_module_t *dp;
+	uint8_t mask = 0;
+	unsigned char flag = 0;
+
+	STATUS_CHECK_POINTER(port);
+	STATUS_CHECK_POINTER(pmux);
+
+	for(uint8_t i = 0; i < pmux->npins; i++)
+		mask |= (1 << pmux->pins[i]);
+
+	lock_acquire(&gpio_lock);
+	if(port_status[pmux->port] & mask)
+		flag = 1;
+	else
+		port_status[pmux->port] |= mask;
+	lock_release(&gpio_lock);
+
+	if(flag)
+	{
+		sysdbg4("GPIO Pins %x on Port %d are already taken\n", mask, pmux->port);
+		return error_driver_busy;
+	}
+
+	devprop_fetch_pmux(pmux, &vres);
+	if(vres.status != success)
+	{
+		sysdbg4("GPIO Port %d not found in DP\n", pmux->port);
+		lock_acquire(&gpio_lock);
+		port_status[pmux->port] &= ~mask;
+		lock_release(&gpio_lock);
+		return vres.status;
+	}
+	dp = (gpio_module_t *)vres.p;
+	for(uint8_t i = 0; i < pmux->npins; i++)
+	{
+		port[i].pbaddr = dp->baddr;
+		port[i].port = pmux->port;
+		port[i].pin = pmux->pins[i];
+	}
+	sysdbg4("Using GPIO Pins %x on Port %d\n", mask, pmux->port);
+	return success;
+}
+
 /**
  * gpio_pin_mode - Sets GPIO pin mode
  *
@@ -229,7 +288,7 @@ status_t gpio_port_alloc(gpio_port_t *port, uint8_t portID)
 
 	port->pin = (uint8_t)((uint16_t)(1 << BIT) - 1);
 	port->port = portID;
-	arch_visor_call(fetch_dp, gpio, portID, 0, &vres);
+	devprop_fetch_dp(gpio, portID, &vres);
 	if(vres.status != success)
 	{
 		sysdbg4("GPIO Port %d not found in DP\n", portID);
@@ -15,6 +15,7 @@
 #include <syslog.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include <hal/timer.h>
 #include <hal/pwm.h>
@@ -56,7 +57,7 @@ status_t pwm_get_properties(pwm_port_t *port, sw_devid_t dev)
 	module_t *dp;
 	hw_devid_t devid;
 
-	arch_visor_call(fetch_sp, dev, 0, 0, &vres);
+	devprop_fetch_sp(dev, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("%p - sp node could not be found!\n", dev);
@@ -67,7 +68,7 @@ status_t pwm_get_properties(pwm_port_t *port, sw_devid_t dev)
 	devid = sp->hwdev_id;
 	port->pmux = sp->pmux;
 
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0xf0), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0xf0), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("PWM (timer) Device %d not found!\n", devid);
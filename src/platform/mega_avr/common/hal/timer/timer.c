@@ -123,6 +123,38 @@ status_t timer_read(const timer_port_t *port, size_t *value)
 	return success;
 }
 
+/**
+ * timer_set_value - Set compare value
+ *
+ * @brief Updates compare value of the timer without
+ * reconfiguring mode, prescaler and interrupt. Counter is
+ * restarted, else if it is already past the new value the
+ * match is missed until the counter wraps.
+ *
+ * @param[in] port: Pointer to the timer port structure
+ * @param[in] value: Compare value to set
+ *
+ * @return status: Status of timer set operation
+ */
+
+status_t timer_set_value(const timer_port_t *port, size_t value)
+{
+	unsigned id;
+	STATUS_CHECK_POINTER(port);
+	id = port->port_id & 0xf0;
+	if(id == 0 || id == 0x20)
+	{
+		timer8_set(port, (uint8_t) value);
+		timer8_clear(port);
+	}
+	else
+	{
+		timer16_set(port, value);
+		timer16_clear(port);
+	}
+	return success;
+}
+
 /**
  * timer_pwm_set - Set PWM value
  *
@@ -112,3 +112,8 @@ static uint16_t timer16_read(const timer_port_t *port)
 {
 	return MMIO16(port->baddr + TCNTL_16B_OFFSET);
 }
+
+static void timer16_clear(const timer_port_t *port)
+{
+	MMIO16(port->baddr + TCNTL_16B_OFFSET) = 0;
+}
@@ -102,3 +102,8 @@ static uint8_t timer8_read(const timer_port_t *port)
 {
 	return (uint8_t)MMIO8(port->baddr + TCNT_8B_OFFSET);
 }
+
+static void timer8_clear(const timer_port_t *port)
+{
+	MMIO8(port->baddr + TCNT_8B_OFFSET) = 0;
+}
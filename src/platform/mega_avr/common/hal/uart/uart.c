@@ -21,6 +21,7 @@
 #include <interrupt.h>
 #include <hal/uart.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include "uart_private.h"
 
@@ -44,7 +45,7 @@ status_t uart_setup(uart_port_t *port, direction_t d, parity_t p)
 	MMIO8(port->baddr + UCSRA_OFFSET) = 0x00;
 	platform_clk_en(port->clk_id);
 	vret_t vres;
-	arch_visor_call(fetch_dp, clock, 0, 0, &vres);
+	devprop_fetch_dp(clock, 0, &vres);
 	if(vres.status != success)
 		return vres.status;
 	unsigned long *clk = (unsigned long *)vres.p;
@@ -132,6 +133,55 @@ status_t uart_shutdown(uart_port_t *port)
 	return ret;
 }
 
+/**
+ * uart_suspend - Suspend UART port
+ *
+ * @brief Disables transmitter, receiver and interrupts, then gates
+ * the clock of UART. Port configuration and linked interrupts are
+ * retained for uart_resume. Caller needs to make sure that the last
+ * frame has been shifted out (TXC) before calling this. With rx_wake,
+ * only transmitter is stopped, receiver needs the clock to wake core.
+ *
+ * @param[in] port: Pointer to the UART port structure
+ *
+ * @return status: error_driver_busy if data is still queued in UDR
+ */
+
+status_t uart_suspend(uart_port_t *port)
+{
+	STATUS_CHECK_POINTER(port);
+	if(!(MMIO8(port->baddr + UCSRA_OFFSET) & (1 << UDRE)))
+		return error_driver_busy;
+	port->pm_ctx = MMIO8(port->baddr + UCSRB_OFFSET);
+	if(port->rx_wake)
+	{
+		MMIO8(port->baddr + UCSRB_OFFSET) &= ((1 << RXEN) | (1 << RXCIE));
+		return success;
+	}
+	MMIO8(port->baddr + UCSRB_OFFSET) = 0x00;
+	return platform_clk_dis(port->clk_id);
+}
+
+/**
+ * uart_resume - Resume UART port
+ *
+ * @brief Ungates the clock of UART and restores the state
+ * saved by uart_suspend.
+ *
+ * @param[in] port: Pointer to the UART port structure
+ *
+ * @return status: Status of UART resume operation
+ */
+
+status_t uart_resume(uart_port_t *port)
+{
+	status_t ret;
+	STATUS_CHECK_POINTER(port);
+	ret = platform_clk_en(port->clk_id);
+	MMIO8(port->baddr + UCSRB_OFFSET) = (uint8_t) port->pm_ctx;
+	return ret;
+}
+
 /**
  * uart_buffer_available - Check if UART buffer is free for transmission
  *
@@ -9,6 +9,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <status.h>
 #include <syslog.h>
 #include <stdlib.h>
@@ -16,6 +17,7 @@
 #include <driver.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include <hal/timer.h>
 #include <terravisor/timer.h>
@@ -44,11 +46,44 @@ static uint64_t ticks;
  */
 static uint64_t cntr;
 
+/**
+ * tpms - Timer ticks per milli second
+ */
+static uint64_t tpms;
+
+/**
+ * period, remain, chunk - Event period and its progress in msec
+ *
+ * Compare register can hold only few msec worth of ticks, so
+ * longer periods (e.g. tickless idle) are made of multiple
+ * chunks of at most max_chunk msec each and callback is executed
+ * once per period.
+ */
+static unsigned int period, remain, chunk, max_chunk;
+
 /**
  * tm - timer device module
  */
 static module_t *tm;
 
+/**
+ * plat_timer_load - Programs compare register for 'ms' msec
+ *
+ * Counter restarts from 0, ticks counted so far in the running
+ * chunk are added to cntr so that no time is lost.
+ */
+static void plat_timer_load(unsigned int ms)
+{
+	size_t elapsed;
+
+	timer_read(tport, &elapsed);
+	cntr += elapsed;
+	chunk = ms;
+	ticks = (tpms * ms) - 1;
+	tport->value = (size_t) ticks;
+	timer_set_value(tport, tport->value);
+}
+
 /**
  * plat_tmr_isr - platform timer isr handler
  *
@@ -58,8 +93,19 @@ static module_t *tm;
  */
 static void plat_tmr_isr(void)
 {
-	cntr += ticks;
-	if(tmr_cb != NULL)
+	bool elapsed;
+	unsigned int next;
+
+	cntr += ticks + 1;
+	remain -= chunk;
+	elapsed = (remain == 0);
+	if(elapsed)
+		remain = period;
+	next = (remain < max_chunk) ? remain : max_chunk;
+	if(next != chunk)
+		plat_timer_load(next);
+
+	if(elapsed && tmr_cb != NULL)
 		tmr_cb();
 }
 
@@ -80,7 +126,7 @@ static status_t plat_get_timer_prop(void)
 	swdev_t *sp;
 	hw_devid_t devid;
 
-	arch_visor_call(fetch_sp, sched_timer, 0, 0, &vres);
+	devprop_fetch_sp(sched_timer, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("%p - sp node could not be found!\n", sched_timer);
@@ -89,7 +135,7 @@ static status_t plat_get_timer_prop(void)
 	sp = (swdev_t *) vres.p;
 	devid = sp->hwdev_id;
 
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0xff), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0xff), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("Timer Device %d not found!\n", devid);
@@ -119,10 +165,14 @@ static uint64_t plat_get_timer_ticks_msec(uint64_t freq)
  */
 static void plat_timer_set_period(unsigned int p)
 {
-	uint64_t nt = plat_get_timer_ticks_msec(tm->clk);
-	ticks = (nt * p) - 1;
-	tport->value = (size_t) ticks;
-	timer_setup(tport, 2, PS);
+	istate_t istate;
+	if(!p)
+		return;
+	arch_di_save_state(&istate);
+	period = p;
+	remain = p;
+	plat_timer_load((p < max_chunk) ? p : max_chunk);
+	arch_ei_restore_state(&istate);
 }
 
 /**
@@ -143,10 +193,7 @@ static uint64_t plat_read_ticks(void)
  */
 static uint64_t plat_read_time(void)
 {
-	uint64_t stamp = cntr;
-	stamp <<= 10U;
-	stamp /= ((tport->value + 1) << 1);
-	return stamp;
+	return (cntr * 1000U) / tpms;
 }
 
 /**
@@ -187,10 +234,24 @@ static status_t plat_timer_setup()
 	tport->tmr_irq = (size_t) tm->interrupt[0].id;
 	tport->tmr_handler = plat_tmr_isr;
 
+	tpms = plat_get_timer_ticks_msec(tm->clk);
+	/* Longest chunk that fits 8/16 bit compare register */
+	max_chunk = (((tm->id & 0xf0) == 0 || (tm->id & 0xf0) == 0x20) ? 0x100UL : 0x10000UL) / tpms;
+	if(!max_chunk)
+	{
+		ret = error_system_clk_caliberation;
+		goto cleanup_exit1;
+	}
+
+	/* Compare register is loaded by timer_setup, so set 1 msec period first */
+	period = 1;
+	remain = 1;
+	chunk = 1;
+	ticks = tpms - 1;
+	tport->value = (size_t) ticks;
 	ret |= timer_setup(tport, 2, PS);
 	if(ret)
 		goto cleanup_exit2;
-	plat_timer_set_period(1);
 	ret = timer_attach_device(ret, &plat_timer_port);
 	if(!ret)
 		goto exit;
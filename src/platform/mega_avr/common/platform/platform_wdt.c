@@ -17,6 +17,7 @@
 #include <driver.h>
 #include <resource.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <arch.h>
 #include <hal/wdt.h>
 #include <driver/watchdog.h>
@@ -47,7 +48,7 @@ static status_t platform_wdt_setup()
 {
 	vret_t vres;
 	module_t *dp;
-	arch_visor_call(fetch_dp, wdt, 0, 0, &vres);
+	devprop_fetch_dp(wdt, 0, &vres);
 
 	if(vres.status != success)
 	{
@@ -15,6 +15,7 @@
 #include <assert.h>
 #include <mmio.h>
 #include <resource.h>
+#include <devprop.h>
 #include <arch.h>
 #include <lock/lock.h>
 #include <hal/gpio.h>
@@ -42,7 +43,7 @@ status_t gpio_pin_alloc(gpio_port_t *port, uint8_t portID, uint8_t pinID)
 
 	port->pin = pinID;
 	port->port = portID;
-	arch_visor_call(fetch_dp, gpio, portID, 0, &vres);
+	devprop_fetch_dp(gpio, portID, &vres);
 	if(vres.status != success)
 	{
 		sysdbg("GPIO Port %d not found in DP\n", portID);
@@ -55,6 +56,51 @@ status_t gpio_pin_alloc(gpio_port_t *port, uint8_t portID, uint8_t pinID)
 	return success;
 }
 
+status_t gpio_pmux_alloc(gpio_port_t *port, pinmux_t *pmux)
+{
+	vret_t vres;
+	const gpio_module_t *dp;
+	uint32_t mask = 0;
+	unsigned char flag;
+
+	for(uint8_t i = 0; i < pmux->npins; i++)
+		mask |= (1U << pmux->pins[i]);
+
+	flag = 0;
+	lock_acquire(&gpio_key);
+	if(port_status[pmux->port] & mask)
+		flag = 1;
+	else
+		port_status[pmux->port] |= mask;
+	lock_release(&gpio_key);
+
+	if(flag)
+	{
+		sysdbg("GPIO Pins %x on Port %d are already taken\n", mask, pmux->port);
+		return error_driver_busy;
+	}
+
+	/* One property lookup serves all the pins of pinmux */
+	devprop_fetch_pmux(pmux, &vres);
+	if(vres.status != success)
+	{
+		sysdbg("GPIO Port %d not found in DP\n", pmux->port);
+		lock_acquire(&gpio_key);
+		port_status[pmux->port] &= ~mask;
+		lock_release(&gpio_key);
+		return vres.status;
+	}
+	dp = (gpio_module_t *)vres.p;
+	for(uint8_t i = 0; i < pmux->npins; i++)
+	{
+		port[i].pbaddr = dp->baddr;
+		port[i].port = pmux->port;
+		port[i].pin = pmux->pins[i];
+	}
+	sysdbg("Using GPIO Pins %x on Port %d\n", mask, pmux->port);
+	return success;
+}
+
 status_t gpio_pin_mode(const gpio_port_t *port, gpio_mode_t mode)
 {
 	uintptr_t baddr;
@@ -16,6 +16,7 @@
 #include <syslog.h>
 #include <arch.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <resource.h>
 #include <driver/sysclk.h>
 #include <driver/interrupt_controller.h>
@@ -31,7 +32,7 @@ status_t uart_get_properties(uart_port_t *port, sw_devid_t dev)
 	module_t *dp;
 	hw_devid_t devid;
 
-	arch_visor_call(fetch_sp, dev, 0, 0, &vres);
+	devprop_fetch_sp(dev, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("%p - sp node could not be found!\n", dev);
@@ -41,7 +42,7 @@ status_t uart_get_properties(uart_port_t *port, sw_devid_t dev)
 	devid = sp->hwdev_id;
 	port->pmux = sp->pmux;
 
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0xff), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0xff), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("UART Device %d not found!\n", devid);
@@ -64,11 +65,9 @@ status_t uart_setup(uart_port_t *port, direction_t d, parity_t p _UNUSED)
 	volatile uint32_t txctlr = 0;
 	volatile uint32_t rxctlr = 0;
 
+	ret |= gpio_pmux_alloc(port->io, port->pmux);
 	for(uint8_t i = 0; i < port->pmux->npins; i++)
-	{
-		ret |= gpio_pin_alloc(&port->io[i], port->pmux->port, port->pmux->pins[i]);
 		ret |= gpio_enable_alt_io(&port->io[i], port->pmux->function);
-	}
 
 	switch(d)
 	{
@@ -132,6 +131,49 @@ status_t uart_shutdown(uart_port_t *port)
 	return ret;
 }
 
+/*
+ * Suspend only stops the engines and masks the interrupts,
+ * FIFO contents, watermarks and baud are retained. With rx_wake,
+ * receiver and Rx irq are left running.
+ */
+status_t uart_suspend(uart_port_t *port)
+{
+	unsigned int ctx = 0;
+
+	if(MMIO32(port->baddr + TXCTRL_OFFSET) & (1 << TXEN))
+		ctx |= (1 << 0);
+	if(MMIO32(port->baddr + RXCTRL_OFFSET) & (1 << RXEN))
+		ctx |= (1 << 1);
+	ctx |= (MMIO32(port->baddr + UARTIE_OFFSET) & ((1 << TXWM) | (1 << RXWM))) << 2;
+	port->pm_ctx = ctx;
+
+	MMIO32(port->baddr + TXCTRL_OFFSET) &= ~(1 << TXEN);
+	if(port->rx_wake)
+	{
+		MMIO32(port->baddr + UARTIE_OFFSET) &= (1 << RXWM);
+	}
+	else
+	{
+		MMIO32(port->baddr + UARTIE_OFFSET) = 0;
+		MMIO32(port->baddr + RXCTRL_OFFSET) &= ~(1 << RXEN);
+	}
+	arch_dsb();
+	return success;
+}
+
+status_t uart_resume(uart_port_t *port)
+{
+	unsigned int ctx = port->pm_ctx;
+
+	if(ctx & (1 << 0))
+		MMIO32(port->baddr + TXCTRL_OFFSET) |= (1 << TXEN);
+	if(ctx & (1 << 1))
+		MMIO32(port->baddr + RXCTRL_OFFSET) |= (1 << RXEN);
+	MMIO32(port->baddr + UARTIE_OFFSET) = (ctx >> 2) & ((1 << TXWM) | (1 << RXWM));
+	arch_dsb();
+	return success;
+}
+
 void uart_update_baud(const uart_port_t *port)
 {
 	unsigned int plat_clk;
@@ -13,11 +13,13 @@
 #include <status.h>
 #include <syslog.h>
 #include <stdlib.h>
+#include <mempool.h>
 #include <assert.h>
 #include <arch.h>
 #include <driver.h>
 #include <interrupt.h>
 #include <visor_call.h>
+#include <devprop.h>
 #include <resource.h>
 #include <platform.h>
 #include <hal/clint.h>
@@ -34,6 +36,12 @@ static void (*tmr_cb)(void);
  */
 static uint64_t ticks;
 
+/**
+ * tpms - Timer ticks per milli second, computed once at setup
+ * as period is reprogrammed frequently by tickless scheduler
+ */
+static uint64_t tpms;
+
 /**
  * tm - timer device module
  */
@@ -83,7 +91,7 @@ static status_t plat_get_timer_prop(void)
 	swdev_t *sp;
 	hw_devid_t devid;
 
-	arch_visor_call(fetch_sp, sched_timer, 0, 0, &vres);
+	devprop_fetch_sp(sched_timer, &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("%p - sp node could not be found!\n", sched_timer);
@@ -92,7 +100,7 @@ static status_t plat_get_timer_prop(void)
 	sp = (swdev_t *) vres.p;
 	devid = sp->hwdev_id;
 
-	arch_visor_call(fetch_dp, (devid & 0xff00), (devid & 0xff), 0, &vres);
+	devprop_fetch_dp((devid & 0xff00), (devid & 0xff), &vres);
 	if(vres.status != success)
 	{
 		sysdbg3("Timer Device %d not found!\n", devid);
@@ -123,8 +131,7 @@ static void plat_timer_set_period(unsigned int p)
 {
 	uint64_t nt;
 	arch_di_mtime();
-	ticks = plat_get_timer_ticks_msec(tm->clk);
-	ticks *= p;
+	ticks = tpms * p;
 	nt = ticks + clint_read_time();
 	status_t ret = clint_config_tcmp(arch_core_index(), nt);
 	if(ret)
@@ -154,6 +161,7 @@ static uint64_t plat_read_time(void)
 /**
  * Driver ops for linking timer
  */
+INCLUDE_MEMPOOL(plat_timer_pool, tvisor_timer_t, 1);
 static tvisor_timer_t *plat_timer_port;
 
 /**
@@ -166,7 +174,7 @@ status_t plat_timer_setup(void)
 	const irqs_t *irq;
 	arch_di_mtime();
 
-	plat_timer_port = (tvisor_timer_t *)malloc(sizeof(tvisor_timer_t));
+	plat_timer_port = (tvisor_timer_t *)mempool_alloc(&plat_timer_pool);
 	if(!plat_timer_port)
 		return error_memory_low;
 	plat_timer_port->read_ticks = &clint_read_time;
@@ -176,11 +184,17 @@ status_t plat_timer_setup(void)
 
 	/* This funcition fetches device properties */
 	ret |= plat_get_timer_prop();
+	tpms = plat_get_timer_ticks_msec(tm->clk);
 
 	irq = &tm->interrupt[0];
 
 	/* Link timer isr handle */
 	ret |= link_interrupt(irq->module, irq->id, &plat_tmr_isr);
+#if PLAT_TIMER_FAST_IRQ
+	/* Skip generic trap bookkeeping for the tick */
+	if(irq->module == int_local)
+		local_register_fast_handler(irq->id, &plat_tmr_isr);
+#endif
 	ret |= timer_attach_device(ret, plat_timer_port);
 	plat_timer_set_period(1);
 	return ret;
@@ -197,11 +211,16 @@ status_t plat_timer_exit(void)
 	tmr_cb = (void *) 0;
 	ticks = 0;
 	irq = &tm->interrupt[0];
+#if PLAT_TIMER_FAST_IRQ
+	if(irq->module == int_local)
+		local_register_fast_handler(irq->id, NULL);
+#endif
 	unlink_interrupt(irq->module, irq->id);
-	free(plat_timer_port);
+	mempool_free(&plat_timer_pool, plat_timer_port);
+	plat_timer_port = NULL;
 	return timer_release_device();
 }
 
 #if USE_TIMER
-INCLUDE_DRIVER(plat_timer, plat_timer_setup, plat_timer_exit, 0, 1, 1);
+INCLUDE_DRIVER_DEPS(plat_timer, plat_timer_setup, plat_timer_exit, 0, 1, 1, 0, "plat_clint");
 #endif
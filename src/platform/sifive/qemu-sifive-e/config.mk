@@ -62,6 +62,9 @@ $(eval $(call add_define,MAX_INTERRUPTS_PER_DEVICE))
 USE_SPINLOCK	?= 1
 $(eval $(call add_define,USE_SPINLOCK))
 
+RV_VEC_MODE	?= 1
+$(eval $(call add_define,RV_VEC_MODE))
+
 #======================================================================
 # MEMBUF Configuration
 #======================================================================
@@ -97,6 +100,10 @@ $(eval $(call add_define,PRCI_CLK))
 #======================================================================
 USE_TIMER	?= 1
 $(eval $(call add_define,USE_TIMER))
+
+# Service timer irq via fast handler, effective with RV_VEC_MODE
+PLAT_TIMER_FAST_IRQ	?= 1
+$(eval $(call add_define,PLAT_TIMER_FAST_IRQ))
 #======================================================================
 
 #======================================================================
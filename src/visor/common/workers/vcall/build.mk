@@ -10,6 +10,14 @@
 
 VCALL_DIR	:= $(GET_PATH)
 
+# Log every visor call, very slow, meant for debugging only
+VCALL_TRACE	?= 0
+$(eval $(call add_define,VCALL_TRACE))
+
+# Count calls per ID, dump using vcall_stats_dump()
+VCALL_STATS	?= 0
+$(eval $(call add_define,VCALL_STATS))
+
 DIR		:= $(VCALL_DIR)
 
 include mk/obj.mk
@@ -9,7 +9,9 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <status.h>
+#include <stdio.h>
 #include <syslog.h>
 #include <visor_call.h>
 #include <platform.h>
@@ -19,22 +21,86 @@
 extern vcall_t _vcall_table_start;
 extern vcall_t _vcall_table_end;
 
-typedef void (*vcb_t)(call_arg_t, call_arg_t, call_arg_t, vret_t *);
-static vcb_t get_callback_from_table(const vcall_t *start, const vcall_t *end, vcall_id_t id)
+/*
+ * Every ID maps to a fixed slot of dispatch index, groups of IDs
+ * are packed one after the other. Index holds position of entry in
+ * vcall table + 1, 0 means no handler registered for the ID.
+ */
+#define N_BASE_VCALLS		((vcall_base_end & VCALL_GRP_MASK) - 1)
+#define N_PTHREAD_VCALLS	((vcall_pthread_end & VCALL_GRP_MASK) - 1)
+#define N_IPC_VCALLS		((vcall_ipc_end & VCALL_GRP_MASK) - 1)
+#define N_VCALLS		(N_BASE_VCALLS + N_PTHREAD_VCALLS + N_IPC_VCALLS)
+#define N_VCALL_GRPS		3
+
+static const uint8_t grp_size[N_VCALL_GRPS] =
+{
+	N_BASE_VCALLS, N_PTHREAD_VCALLS, N_IPC_VCALLS
+};
+
+static const uint8_t grp_offset[N_VCALL_GRPS] =
+{
+	0, N_BASE_VCALLS, N_BASE_VCALLS + N_PTHREAD_VCALLS
+};
+
+static uint8_t vcall_index[N_VCALLS];
+static bool vcall_index_ready;
+
+#if VCALL_STATS
+/* Last counter is for calls with invalid IDs */
+static unsigned long vcall_count[N_VCALLS + 1];
+#endif
+
+static int vcall_slot(vcall_id_t id)
+{
+	unsigned int grp = (unsigned int)id >> VCALL_GRP_SHIFT;
+	unsigned int idx = ((unsigned int)id & VCALL_GRP_MASK) - 1;
+	if(grp >= N_VCALL_GRPS || idx >= grp_size[grp])
+		return -1;
+	return grp_offset[grp] + idx;
+}
+
+/*
+ * Index is built on first visor call, if more than one entry is
+ * registered for an ID, the first one in table is used.
+ */
+static void vcall_index_build(const vcall_t *start, const vcall_t *end)
 {
-	vcall_t *ptr = (vcall_t *)start;
-	while(ptr < end)
+	const vcall_t *ptr;
+	unsigned int pos = 1;
+	int slot;
+	for(ptr = start; ptr < end && pos <= UINT8_MAX; ptr++, pos++)
 	{
-		if(ptr->id == id)
-			return (ptr->callback != NULL) ? ptr->callback : NULL;
-		ptr++;
+		slot = vcall_slot(ptr->id);
+		if(slot >= 0 && !vcall_index[slot])
+			vcall_index[slot] = (uint8_t)pos;
 	}
-	return (vcb_t) 0;
+	vcall_index_ready = true;
+}
+
+typedef void (*vcb_t)(call_arg_t, call_arg_t, call_arg_t, vret_t *);
+static vcb_t get_callback(vcall_id_t id)
+{
+	int slot;
+	const vcall_t *ptr;
+
+	if(!vcall_index_ready)
+		vcall_index_build(&_vcall_table_start, &_vcall_table_end);
+
+	slot = vcall_slot(id);
+#if VCALL_STATS
+	vcall_count[(slot < 0) ? (int)N_VCALLS : slot]++;
+#endif
+	if(slot < 0 || !vcall_index[slot])
+		return (vcb_t) 0;
+	ptr = &(&_vcall_table_start)[vcall_index[slot] - 1];
+	return ptr->callback;
 }
 
 void vcall_handler(vcall_id_t id, call_arg_t a0, call_arg_t a1, call_arg_t a2, vret_t *ret)
 {
+#if VCALL_TRACE
 	sysdbg4("VCall: id=%p, a0=%p, a1=%p, a2=%p\n", id, a0, a1, a2);
+#endif
 	/* Callback function pointer */
 	vcb_t cb;
 
@@ -45,8 +111,27 @@ void vcall_handler(vcall_id_t id, call_arg_t a0, call_arg_t a1, call_arg_t a2, v
 	ret->size = 0;
 	ret->status = error_vcall_code_inval;
 
-	cb = get_callback_from_table(&_vcall_table_start, &_vcall_table_end, id);
+	cb = get_callback(id);
 	if(cb != 0)
 		cb(a0, a1, a2, ret);
 	return;
 }
+
+void vcall_stats_dump(void)
+{
+#if VCALL_STATS
+	unsigned int grp, idx;
+	unsigned long cnt;
+	for(grp = 0; grp < N_VCALL_GRPS; grp++)
+	{
+		for(idx = 0; idx < grp_size[grp]; idx++)
+		{
+			cnt = vcall_count[grp_offset[grp] + idx];
+			if(cnt)
+				printf("VCall: id=%p, calls=%lu\n",
+					(grp << VCALL_GRP_SHIFT) | (idx + 1), cnt);
+		}
+	}
+	printf("VCall: invalid, calls=%lu\n", vcall_count[N_VCALLS]);
+#endif
+}
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <status.h>
 #include <syslog.h>
+#include <boottrace.h>
 #include <arch.h>
 #include <terravisor/platform.h>
 #include <terravisor/bootstrap.h>
@@ -19,19 +20,30 @@
 status_t bootstrap()
 {
 	reset_t resetSyndrome;
+	unsigned long t_entry, t_arch_early;
 
+	t_entry = boottrace_stamp();
 	arch_early_setup();
+	t_arch_early = boottrace_stamp();
 
 	platform_early_setup();
 
+	/* Trace records live in .bss, which is ready only now */
+	boottrace_mark_at("bootstrap", t_entry);
+	boottrace_mark_at("arch_early_setup", t_arch_early);
+	boottrace_mark("platform_early_setup");
+
 	arch_setup();
+	boottrace_mark("arch_setup");
 
 	platform_setup();
+	boottrace_mark("platform_setup");
 
 	resetSyndrome = platform_get_reset_syndrome();
 	platform_reset_handler(resetSyndrome);
 
 	platform_cpu_setup();
+	boottrace_mark("platform_cpu_setup");
 
 	return success;
 }
@@ -114,6 +114,27 @@ status_t timer_link_callback(unsigned int p, void *cb)
 	return success;
 }
 
+/**
+ * timer_set_period - This function updates period of timer irq
+ *
+ * @brief This function reprograms period of timer events without
+ * touching the linked callback. Unlike other timer functions it
+ * does not take the lock, so that it can be called from the timer
+ * callback or with interrupts disabled, e.g. by tickless schedulers.
+ *
+ * @param[in] p: period of timer irq in milli seconds
+ * @return status
+ */
+status_t timer_set_period(unsigned int p)
+{
+	size_t cpu_index = arch_core_index();
+	tvisor_timer_t *ptr = port[cpu_index];
+	if(!timer_attached[cpu_index])
+		return error_driver_init_failed;
+	ptr->set_period(p);
+	return success;
+}
+
 /**
  * get_timestamp - This funtion reads timestamp
  *
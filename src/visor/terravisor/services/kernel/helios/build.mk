@@ -14,19 +14,33 @@ HELIOS_IDLE_TASK_PRIORITY	:= 1
 HELIOS_USE_DYNAMIC 		?= 1
 HELIOS_HEAP_SIZE 		?= 1024
 HELIOS_MAX_THREAD 		?= 2
+HELIOS_MAX_SEM			?= 2
+HELIOS_MAX_MUTEX		?= 2
+HELIOS_MAX_EVT			?= 2
+HELIOS_PRIORITY_LEVELS		?= 32
 HELIOS_IDLE_TASK_NAME		?= \"HELIOS_IDLE\"
 HELIOS_IDLE_TASK_STACK_LEN 	?= 255
+HELIOS_TICK_MS			?= 1
 HELIOS_POWER_SAVE_EN 		?= 0
+HELIOS_TICKLESS_MAX		?= 1000
+HELIOS_DRIVER_PM_EN		?= 1
 HELIOS_ANTI_DEADLOCK		?= 1
 HELIOS_DEBUG			?= 1
 
 $(eval $(call add_define,HELIOS_USE_DYNAMIC))
 $(eval $(call add_define,HELIOS_HEAP_SIZE))
 $(eval $(call add_define,HELIOS_MAX_THREAD))
+$(eval $(call add_define,HELIOS_MAX_SEM))
+$(eval $(call add_define,HELIOS_MAX_MUTEX))
+$(eval $(call add_define,HELIOS_MAX_EVT))
+$(eval $(call add_define,HELIOS_PRIORITY_LEVELS))
 $(eval $(call add_define,HELIOS_IDLE_TASK_NAME))
 $(eval $(call add_define,HELIOS_IDLE_TASK_PRIORITY))
 $(eval $(call add_define,HELIOS_IDLE_TASK_STACK_LEN))
+$(eval $(call add_define,HELIOS_TICK_MS))
 $(eval $(call add_define,HELIOS_POWER_SAVE_EN))
+$(eval $(call add_define,HELIOS_TICKLESS_MAX))
+$(eval $(call add_define,HELIOS_DRIVER_PM_EN))
 $(eval $(call add_define,HELIOS_ANTI_DEADLOCK))
 $(eval $(call add_define,HELIOS_DEBUG))
 
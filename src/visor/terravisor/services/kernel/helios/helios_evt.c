@@ -0,0 +1,228 @@
+/*
+ * CYANCORE LICENSE
+ * Copyrights (C) 2026, Cyancore Team
+ *
+ * File Name		: helios_evt.c
+ * Description		: CC OS event group function definations
+ * Primary Author	: agent [agent@local]
+ * Organisation		: Cyancore Core-Team
+ */
+
+/*****************************************************
+ *	INCLUDES
+ *****************************************************/
+#include <terravisor/helios/helios.h>
+
+/*****************************************************
+ *	GLOBAL EXTERNS
+ *****************************************************/
+extern helios_sched_ctrl_t g_sched_ctrl;
+extern void _helios_sched_waiter_add(helios_sched_tcb_t ** wait_q, helios_sched_tcb_t * ptr, uintptr_t resource, helios_sched_tcb_t ** owner);
+extern void _helios_sched_send_to_resume(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr);
+extern void _helios_sched_preempt_check(helios_sched_ctrl_t * sched_ctrl, const helios_sched_tcb_t * woken);
+/*****************************************************
+ *	STATIC FUNCTION DEFINATIONS
+ *****************************************************/
+/**
+ * @brief	Check if event bits satisfy a wait condition
+ *
+ * @param evt_bits[in]		Current event bits
+ * @param bits[in]		Bits waited on
+ * @param opt[in]		Wait options
+ *
+ * @return	true if the wait is satisfied
+ */
+static inline bool __helios_evt_match(uint32_t evt_bits, uint32_t bits, uint8_t opt)
+{
+	if (opt & helios_evt_wait_all)
+	{
+		return (evt_bits & bits) == bits;
+	}
+	return (evt_bits & bits) != 0;
+}
+
+/*****************************************************
+ *	USER FUNCTION DEFINATIONS
+ *****************************************************/
+
+status_t helios_evt_create (helios_evt_t ** evt_ptr)
+{
+	HELIOS_ASSERT_IF_FALSE(evt_ptr != HELIOS_NULL_PTR);
+#if HELIOS_DYNAMIC == false
+	HELIOS_ASSERT_IF_FALSE(*evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE((*evt_ptr)->evt_init == false);
+#else
+	HELIOS_ASSERT_IF_FALSE(*evt_ptr == HELIOS_NULL_PTR);
+	/* Create event group */
+	*evt_ptr = helios_obj_alloc(helios_obj_evt);
+	if (*evt_ptr == HELIOS_NULL_PTR)
+	{
+		HELIOS_ERR("Memory low for evt create");
+		return error_memory_low;
+	}
+#endif 	/* HELIOS_DYNAMIC */
+	/* Fill up the init details */
+	(*evt_ptr)->evt_bits = 0;
+	(*evt_ptr)->wait_q = HELIOS_NULL_PTR;
+	(*evt_ptr)->evt_init = true;
+
+	return success;
+}
+status_t helios_evt_wait (helios_evt_t * evt_ptr, uint32_t bits, uint8_t opt,
+			  uint32_t * val, size_t wait_ticks)
+{
+	HELIOS_ASSERT_IF_FALSE(evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(evt_ptr->evt_init != false);
+	HELIOS_ASSERT_IF_FALSE(bits != 0);
+
+	istate_t istate;
+	status_t ret = success;
+	helios_sched_tcb_t * curr = g_sched_ctrl.curr_task;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	helios_tick_t deadline = HELIOS_DEADLINE(g_sched_ctrl.tick_count, wait_ticks);
+	while (!__helios_evt_match(evt_ptr->evt_bits, bits, opt))
+	{
+		if ((wait_ticks == false) || in_isr())
+		{
+			/* Caller can not wait for the bits to get set */
+			ret = error_os_evt_wait;
+			break;
+		}
+		if ((wait_ticks != HELIOS_DELAY_MAX) && !HELIOS_TICK_AFTER(deadline, g_sched_ctrl.tick_count))
+		{
+			/* Timed out */
+			ret = error_os_evt_wait;
+			break;
+		}
+		/* Queue up as per priority and wait till set or deadline */
+		_helios_sched_waiter_add(&evt_ptr->wait_q, curr, (uintptr_t) evt_ptr, HELIOS_NULL_PTR);
+		curr->wait_res.evt_bits = bits;
+		curr->wait_res.evt_opt = opt;
+		helios_task_wait((wait_ticks == HELIOS_DELAY_MAX) ? HELIOS_DELAY_MAX :
+				 (size_t)(deadline - g_sched_ctrl.tick_count));
+		if (curr->wait_res.handoff != false)
+		{
+			/* Setter has matched and cleared the bits on our behalf */
+			curr->wait_res.handoff = false;
+			if (val != HELIOS_NULL_PTR)
+			{
+				*val = curr->wait_res.evt_bits;
+			}
+			HELIOS_EXIT_CRITICAL(&istate);
+			return success;
+		}
+	}
+	if (val != HELIOS_NULL_PTR)
+	{
+		*val = evt_ptr->evt_bits;
+	}
+	if ((ret == success) && (opt & helios_evt_auto_clear))
+	{
+		evt_ptr->evt_bits &= ~bits;
+	}
+	HELIOS_EXIT_CRITICAL(&istate);
+	return ret;
+}
+status_t helios_evt_set (helios_evt_t * evt_ptr, uint32_t bits)
+{
+	HELIOS_ASSERT_IF_FALSE(evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(evt_ptr->evt_init != false);
+
+	istate_t istate;
+	uint32_t clear = 0;
+	bool last;
+	helios_sched_tcb_t * ptr, * next, * tail, * woken = HELIOS_NULL_PTR;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	evt_ptr->evt_bits |= bits;
+	ptr = evt_ptr->wait_q;
+	if (ptr != HELIOS_NULL_PTR)
+	{
+		/*
+		 * Serve every waiter against the same bits, so that all the
+		 * consumers of an event are released by a single set. Auto
+		 * clear is applied only after the walk.
+		 */
+		tail = ptr->res_link.prev;
+		do
+		{
+			next = ptr->res_link.next;
+			last = (ptr == tail);
+			if (__helios_evt_match(evt_ptr->evt_bits, ptr->wait_res.evt_bits, ptr->wait_res.evt_opt))
+			{
+				if (ptr->wait_res.evt_opt & helios_evt_auto_clear)
+				{
+					clear |= ptr->wait_res.evt_bits;
+				}
+				ptr->wait_res.evt_bits = evt_ptr->evt_bits;
+				_helios_sched_send_to_resume(&g_sched_ctrl, ptr);
+				ptr->wait_res.handoff = true;
+				/* Waiter list is sorted, first woken has highest priority */
+				if (woken == HELIOS_NULL_PTR)
+				{
+					woken = ptr;
+				}
+			}
+			ptr = next;
+		} while (!last);
+		evt_ptr->evt_bits &= ~clear;
+	}
+	if (woken != HELIOS_NULL_PTR)
+	{
+		_helios_sched_preempt_check(&g_sched_ctrl, woken);
+	}
+	HELIOS_EXIT_CRITICAL(&istate);
+
+	return success;
+}
+status_t helios_evt_clear (helios_evt_t * evt_ptr, uint32_t bits)
+{
+	HELIOS_ASSERT_IF_FALSE(evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(evt_ptr->evt_init != false);
+
+	istate_t istate;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	evt_ptr->evt_bits &= ~bits;
+	HELIOS_EXIT_CRITICAL(&istate);
+
+	return success;
+}
+status_t helios_evt_delete (helios_evt_t ** evt_ptr)
+{
+	HELIOS_ASSERT_IF_FALSE(evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(*evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE((*evt_ptr)->evt_init != false);
+
+	istate_t istate;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	/* Waiters keep pointers into the event group */
+	if ((*evt_ptr)->wait_q != HELIOS_NULL_PTR)
+	{
+		HELIOS_EXIT_CRITICAL(&istate);
+		HELIOS_ERR("Event group in use, can not delete");
+		return error_os_invalid_op;
+	}
+	(*evt_ptr)->evt_init = false;
+	HELIOS_EXIT_CRITICAL(&istate);
+
+#if HELIOS_DYNAMIC == true
+	/* Free up allocated space */
+	helios_obj_free(helios_obj_evt, *evt_ptr);
+	*evt_ptr = HELIOS_NULL_PTR;
+#endif
+
+	return success;
+}
+status_t helios_evt_get_val (const helios_evt_t * evt_ptr, uint32_t * val)
+{
+	HELIOS_ASSERT_IF_FALSE(evt_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(evt_ptr->evt_init != false);
+	HELIOS_ASSERT_IF_FALSE(val != HELIOS_NULL_PTR);
+
+	*val = evt_ptr->evt_bits;
+
+	return success;
+}
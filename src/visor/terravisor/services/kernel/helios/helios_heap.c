@@ -12,10 +12,33 @@
  *	INCLUDES
  *****************************************************/
 #include <terravisor/helios/utils/helios_heap.h>
+#include <mempool.h>
 
 /*****************************************************
  *	GLOBAL/STATIC VARIABLE DECLARATIONS
  *****************************************************/
+#if HELIOS_DYNAMIC
+INCLUDE_MEMPOOL(helios_tcb_pool, helios_sched_tcb_t, HELIOS_MAX_THREAD);
+INCLUDE_MEMPOOL(helios_sem_pool, helios_sem_t, HELIOS_MAX_SEM);
+INCLUDE_MEMPOOL(helios_mutex_pool, helios_mutex_t, HELIOS_MAX_MUTEX);
+INCLUDE_MEMPOOL(helios_evt_pool, helios_evt_t, HELIOS_MAX_EVT);
+
+static mempool_t * const __helios_obj_pool[helios_obj_max] =
+{
+	[helios_obj_tcb]	= &helios_tcb_pool,
+	[helios_obj_sem]	= &helios_sem_pool,
+	[helios_obj_mutex]	= &helios_mutex_pool,
+	[helios_obj_evt]	= &helios_evt_pool,
+};
+
+static const size_t __helios_obj_size[helios_obj_max] =
+{
+	[helios_obj_tcb]	= sizeof(helios_sched_tcb_t),
+	[helios_obj_sem]	= sizeof(helios_sem_t),
+	[helios_obj_mutex]	= sizeof(helios_mutex_t),
+	[helios_obj_evt]	= sizeof(helios_evt_t),
+};
+#endif /* HELIOS_DYNAMIC */
 
 /*****************************************************
  *	GLOBAL EXTERNS
@@ -36,3 +59,37 @@ void helios_free(void *addr )
 {
 	free(addr);
 }
+
+#if HELIOS_DYNAMIC
+void * helios_obj_alloc(helios_obj_t obj)
+{
+	void * addr;
+	if (obj >= helios_obj_max)
+	{
+		return HELIOS_NULL_PTR;
+	}
+	addr = mempool_alloc(__helios_obj_pool[obj]);
+	if (addr == HELIOS_NULL_PTR)
+	{
+		/* Pool exhausted, fall back to heap */
+		addr = helios_malloc(__helios_obj_size[obj]);
+	}
+	return addr;
+}
+
+void helios_obj_free(helios_obj_t obj, void *addr)
+{
+	if ((obj >= helios_obj_max) || (addr == HELIOS_NULL_PTR))
+	{
+		return;
+	}
+	if (mempool_owns(__helios_obj_pool[obj], addr))
+	{
+		mempool_free(__helios_obj_pool[obj], addr);
+	}
+	else
+	{
+		helios_free(addr);
+	}
+}
+#endif /* HELIOS_DYNAMIC */
@@ -22,9 +22,40 @@
  *	GLOBAL EXTERNS
  *****************************************************/
 extern helios_sched_ctrl_t g_sched_ctrl;
+extern void _helios_sched_waiter_add(helios_sched_tcb_t ** wait_q, helios_sched_tcb_t * ptr, uintptr_t resource, helios_sched_tcb_t ** owner);
+extern helios_sched_tcb_t * _helios_sched_waiter_wake(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t ** wait_q);
+extern void _helios_sched_set_priority(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr, uint8_t priority);
+extern void _helios_sched_inherit_priority(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * owner, uint8_t priority);
+extern void _helios_sched_preempt_check(helios_sched_ctrl_t * sched_ctrl, const helios_sched_tcb_t * woken);
 /*****************************************************
  *	STATIC FUNCTION DEFINATIONS
  *****************************************************/
+/**
+ * @brief	Drop the priority lent by a timed out waiter
+ * @note	Held mutexes are not tracked per task, so like most small
+ *		kernels the inherited priority is only dropped when the owner
+ *		holds this mutex alone. It then falls back to the base priority
+ *		raised to the highest waiter still queued.
+ *
+ * @param	mutex_ptr[in]	Mutex instance
+ * @param	owner[in_out]	Task owning the mutex
+ *
+ * @return	None
+ */
+static void __helios_mutex_disinherit(const helios_mutex_t * mutex_ptr, helios_sched_tcb_t * owner)
+{
+	uint8_t prio = owner->base_priority;
+
+	if (owner->mutex_held != 1)
+	{
+		return;
+	}
+	if ((mutex_ptr->wait_q != HELIOS_NULL_PTR) && (mutex_ptr->wait_q->priority > prio))
+	{
+		prio = mutex_ptr->wait_q->priority;
+	}
+	_helios_sched_set_priority(&g_sched_ctrl, owner, prio);
+}
 
 /*****************************************************
  *	USER FUNCTION DEFINATIONS
@@ -39,9 +70,11 @@ status_t helios_mutex_create	(helios_mutex_t ** mutex_ptr)
 	/* Initialize values of the mutex struct */
 	(*mutex_ptr)->mutex_init = true;
 	(*mutex_ptr)->mutex_val = MUTEX_INIT_VAL;
+	(*mutex_ptr)->lock_task = HELIOS_NULL_PTR;
+	(*mutex_ptr)->wait_q = HELIOS_NULL_PTR;
 #else
 	HELIOS_ASSERT_IF_FALSE(*mutex_ptr == HELIOS_NULL_PTR);
-	*mutex_ptr = helios_malloc(sizeof(helios_mutex_t));
+	*mutex_ptr = helios_obj_alloc(helios_obj_mutex);
 	if (*mutex_ptr == HELIOS_NULL_PTR)
 	{
 		HELIOS_ERR("Memory low for mutex creation");
@@ -51,6 +84,8 @@ status_t helios_mutex_create	(helios_mutex_t ** mutex_ptr)
 	{
 		/* Initialize values of the mutex struct */
 		(*mutex_ptr)->mutex_val = MUTEX_INIT_VAL;
+		(*mutex_ptr)->lock_task = HELIOS_NULL_PTR;
+		(*mutex_ptr)->wait_q = HELIOS_NULL_PTR;
 		(*mutex_ptr)->mutex_init = true;
 	}
 
@@ -63,44 +98,57 @@ status_t helios_mutex_lock 	(helios_mutex_t * mutex_ptr, size_t wait_ticks)
 	HELIOS_ASSERT_IF_FALSE(mutex_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(mutex_ptr->mutex_init != false);
 
-	bool lock_flag = false;
+	istate_t istate;
+	status_t ret = success;
+	helios_sched_tcb_t * curr = g_sched_ctrl.curr_task;
 
-	if ((mutex_ptr->mutex_val != MUTEX_INIT_VAL) && (mutex_ptr->lock_task != HELIOS_NULL_PTR))
+	HELIOS_ENTER_CRITICAL(&istate);
+	helios_tick_t deadline = HELIOS_DEADLINE(g_sched_ctrl.tick_count, wait_ticks);
+	/* Locking task is allowed to lock recursively */
+	while ((mutex_ptr->mutex_val != MUTEX_INIT_VAL) && (mutex_ptr->lock_task != HELIOS_NULL_PTR) &&
+	       (mutex_ptr->lock_task != curr))
 	{
 		/* If mutex is not free and if the lock task is not NULL. */
-		if (wait_ticks == false) 	/* ||_IS_ISR */
+		if ((wait_ticks == false) || in_isr())
 		{
 			HELIOS_ERR("Mutex already locked");
-			return error_os_mutex_lock;
+			ret = error_os_mutex_lock;
+			break;
 		}
-		else
+		if ((wait_ticks != HELIOS_DELAY_MAX) && !HELIOS_TICK_AFTER(deadline, g_sched_ctrl.tick_count))
 		{
-			/* If mutex is taken, lock_task must already hold info about the task. */
-			if (mutex_ptr->lock_task != g_sched_ctrl.curr_task)
-			{
-				/* If locking task is not current task, wait for mutex */
-				g_sched_ctrl.curr_task->wait_res.wait_on_resource = (uintptr_t) mutex_ptr;
-				helios_task_wait(wait_ticks);
-			}
-			else
-			{
-				/* If locking task is current task or HELIOS_NULL_PTR, allow locking recursively */
-				lock_flag = true;
-			}
+			/* Timed out, owner need not run at our priority anymore */
+			__helios_mutex_disinherit(mutex_ptr, mutex_ptr->lock_task);
+			ret = error_os_mutex_lock;
+			break;
+		}
+		/* Lend our priority to the owner so that it releases the mutex soon */
+		_helios_sched_inherit_priority(&g_sched_ctrl, mutex_ptr->lock_task, curr->priority);
+		/* Wait for mutex till unlock or deadline */
+		_helios_sched_waiter_add(&mutex_ptr->wait_q, curr, (uintptr_t) mutex_ptr, &mutex_ptr->lock_task);
+		helios_task_wait((wait_ticks == HELIOS_DELAY_MAX) ? HELIOS_DELAY_MAX :
+				 (size_t)(deadline - g_sched_ctrl.tick_count));
+		if (curr->wait_res.handoff != false)
+		{
+			/* Ownership was handed over by unlock */
+			curr->wait_res.handoff = false;
+			HELIOS_EXIT_CRITICAL(&istate);
+			return success;
 		}
-	}
-	else
-	{
-		lock_flag = true;
 	}
 
-	if (lock_flag)
+	if (ret == success)
 	{
 		/* Set locking task as current task and acquire lock. */
-		mutex_ptr->lock_task = g_sched_ctrl.curr_task;
+		if (mutex_ptr->lock_task != curr)
+		{
+			curr->mutex_held++;
+		}
+		mutex_ptr->lock_task = curr;
 		mutex_ptr->mutex_val--;
 	}
-	return success;
+	HELIOS_EXIT_CRITICAL(&istate);
+	return ret;
 }
 
 status_t helios_mutex_unlock (helios_mutex_t * mutex_ptr)
@@ -108,34 +156,72 @@ status_t helios_mutex_unlock (helios_mutex_t * mutex_ptr)
 	HELIOS_ASSERT_IF_FALSE(mutex_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(mutex_ptr->mutex_init != false);
 
-	if (mutex_ptr->lock_task != g_sched_ctrl.curr_task)
+	istate_t istate;
+	helios_sched_tcb_t * curr = g_sched_ctrl.curr_task;
+	helios_sched_tcb_t * waiter;
+
+	if (mutex_ptr->lock_task != curr)
 	{
 		HELIOS_ERR("Mutex locked by another task");
 		return error_os_mutex_unlock;
 	}
 	else
 	{
+		HELIOS_ENTER_CRITICAL(&istate);
 		/* Unlock mutex only if current task requests it. */
 		mutex_ptr->mutex_val++;
 		if (mutex_ptr->mutex_val == MUTEX_INIT_VAL)
 		{
 			/* When Unlocked set current task to NULL */
 			mutex_ptr->lock_task = HELIOS_NULL_PTR;
+			curr->mutex_held--;
+			if (curr->mutex_held == false)
+			{
+				/* Inherited priority is kept till the last mutex is released */
+				_helios_sched_set_priority(&g_sched_ctrl, curr, curr->base_priority);
+			}
+			/* Hand the mutex directly to the highest priority waiter */
+			waiter = _helios_sched_waiter_wake(&g_sched_ctrl, &mutex_ptr->wait_q);
+			if (waiter != HELIOS_NULL_PTR)
+			{
+				mutex_ptr->lock_task = waiter;
+				mutex_ptr->mutex_val--;
+				waiter->mutex_held++;
+				/* Remaining waiters now wait on the new owner */
+				if (mutex_ptr->wait_q != HELIOS_NULL_PTR)
+				{
+					_helios_sched_inherit_priority(&g_sched_ctrl, waiter, mutex_ptr->wait_q->priority);
+				}
+				_helios_sched_preempt_check(&g_sched_ctrl, waiter);
+			}
 		}
-
+		HELIOS_EXIT_CRITICAL(&istate);
 	}
 	return success;
 }
 
 status_t helios_mutex_delete (helios_mutex_t ** mutex_ptr)
 {
+	HELIOS_ASSERT_IF_FALSE(mutex_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(*mutex_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE((*mutex_ptr)->mutex_init != false);
 
+	istate_t istate;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	/* Waiters and owner keep pointers into the mutex */
+	if (((*mutex_ptr)->lock_task != HELIOS_NULL_PTR) || ((*mutex_ptr)->wait_q != HELIOS_NULL_PTR))
+	{
+		HELIOS_EXIT_CRITICAL(&istate);
+		HELIOS_ERR("Mutex in use, can not delete");
+		return error_os_invalid_op;
+	}
 	(*mutex_ptr)->mutex_init = false;
+	HELIOS_EXIT_CRITICAL(&istate);
 
 #if HELIOS_DYNAMIC == true
-	helios_free(*mutex_ptr);
+	helios_obj_free(helios_obj_mutex, *mutex_ptr);
+	*mutex_ptr = HELIOS_NULL_PTR;
 #endif
 
 	return success;
@@ -14,6 +14,8 @@
 #include <terravisor/helios/utils/helios_sched.h>
 #include <platform.h>
 #include <syslog.h>
+#include <arch.h>
+#include <terravisor/timer.h>
 
 /*****************************************************
  *	DEFINES
@@ -22,14 +24,14 @@
 	.helios_selected_algo = _id,	\
 	.algo_function = _fn}
 
-#define HELIOS_LINK_WAIT		true
-#define HELIOS_LINK_READY		false
-
 /*****************************************************
  *	STATIC FUNCTION DECLARATION
  *****************************************************/
-static void __helios_sched_deadlock_adjustment_and_detection(const helios_sched_ctrl_t * sched_ctrl);
-static void __helios_sched_wait_list_adjustment(helios_sched_ctrl_t * sched_ctrl);
+static void __helios_sched_deadlock_adjustment_and_detection(helios_sched_ctrl_t * sched_ctrl);
+static void __helios_sched_delay_insert(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * node);
+static void __helios_sched_wake_expired(helios_sched_ctrl_t * sched_ctrl);
+static void __helios_sched_waiter_link(helios_sched_tcb_t ** wait_q, helios_sched_tcb_t * node);
+static void __helios_sched_waiter_detach(helios_sched_tcb_t * node);
 static void __helios_sched_algo_round_robin_fn(helios_sched_ctrl_t * sched_ctrl);
 static void __helios_sched_algo_priority_driven_fn(helios_sched_ctrl_t * sched_ctrl);
 
@@ -50,17 +52,99 @@ helios_sched_t g_helios_sched_list [] =
 
 helios_sched_ctrl_t g_sched_ctrl =
 {
-#if !HELIOS_USE_DYNAMIC
-	.ready_list_head 	= &(g_helios_tcb_list[false]),
-	.curr_task 		= &(g_helios_tcb_list[false]),
-#else
-	.ready_list_head 	= HELIOS_NULL_PTR,
+	.task_list_head 	= HELIOS_NULL_PTR,
+	.idle_task		= HELIOS_NULL_PTR,
 	.curr_task 		= HELIOS_NULL_PTR,
-#endif
-	.wait_list_head		= HELIOS_NULL_PTR,
+	.delay_list_head	= HELIOS_NULL_PTR,
 	.selected_sched		= &(g_helios_sched_list[helios_sched_algo_round_robin])
 };
 
+/*****************************************************
+ *	STATIC HELPER FUNCTIONS
+ *****************************************************/
+/**
+ * @brief	Get the link of a node as per link type
+ *
+ * @param	node[in]	Pointer to task TCB
+ * @param	link_type[in]	HELIOS_LINK_READY / HELIOS_LINK_WAIT / HELIOS_LINK_TASK / HELIOS_LINK_RES
+ *
+ * @return	Pointer to the link
+ */
+static inline link_t * __helios_sched_link(helios_sched_tcb_t * node, uint8_t link_type)
+{
+	if (link_type == HELIOS_LINK_WAIT)
+	{
+		return &node->wait_link;
+	}
+	else if (link_type == HELIOS_LINK_TASK)
+	{
+		return &node->task_link;
+	}
+	else if (link_type == HELIOS_LINK_RES)
+	{
+		return &node->res_link;
+	}
+	return &node->ready_link;
+}
+
+/**
+ * @brief	Get the most significant set bit of a non zero word
+ *
+ * @param	word[in]	Non zero 32bit word
+ *
+ * @return	Bit position
+ */
+static inline uint8_t __helios_sched_msb(uint32_t word)
+{
+	return (uint8_t)(31 - __builtin_clzl(word));
+}
+
+/**
+ * @brief	Get the highest priority ready task
+ *
+ * @param	ready_q[in]	Ready queue
+ *
+ * @return	Head of the highest non-empty priority FIFO
+ */
+static helios_sched_tcb_t * __helios_sched_highest_ready(const helios_ready_queue_t * ready_q)
+{
+	uint8_t word;
+	if (ready_q->prio_grp == false)
+	{
+		return HELIOS_NULL_PTR;
+	}
+	word = __helios_sched_msb(ready_q->prio_grp);
+	return ready_q->prio_head[(word << 5) + __helios_sched_msb(ready_q->prio_map[word])];
+}
+
+/**
+ * @brief	Get the ready task of the next lower non-empty priority
+ * @note	Wraps to the highest priority if no lower priority task is ready
+ *
+ * @param	ready_q[in]	Ready queue
+ * @param	priority[in]	Reference priority
+ *
+ * @return	Head of the next lower non-empty priority FIFO
+ */
+static helios_sched_tcb_t * __helios_sched_next_lower_ready(const helios_ready_queue_t * ready_q, uint8_t priority)
+{
+	uint8_t word = priority >> 5;
+	uint32_t map = ready_q->prio_map[word] & ((1UL << (priority & 0x1f)) - 1);
+
+	if (map == false)
+	{
+		uint8_t grp = ready_q->prio_grp & (uint8_t)((1U << word) - 1);
+		if (grp == false)
+		{
+			/* Wrap around to the highest priority */
+			return __helios_sched_highest_ready(ready_q);
+		}
+		word = __helios_sched_msb(grp);
+		map = ready_q->prio_map[word];
+	}
+	return ready_q->prio_head[(word << 5) + __helios_sched_msb(map)];
+}
+
 /*****************************************************
  *	INTERNAL USED FUNCTIONS (NON-STATIC)
  *****************************************************/
@@ -69,56 +153,41 @@ helios_sched_ctrl_t g_sched_ctrl =
  *
  * @param	ptr[in_out]	Reference pointer address
  * @param	new_node[in]	Node to be inserted
- * @param 	link_type[in]	HELIOS_LINK_READY / HELIOS_LINK_WAIT
+ * @param 	link_type[in]	HELIOS_LINK_READY / HELIOS_LINK_WAIT / HELIOS_LINK_TASK
  *
  * @return	None
 */
 status_t _helios_sched_insert_after(helios_sched_tcb_t ** ptr, helios_sched_tcb_t * new_node, uint8_t link_type)
 {
+	HELIOS_ASSERT_IF_FALSE(ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(new_node != HELIOS_NULL_PTR);
-	if (link_type == HELIOS_LINK_WAIT)
+
+	link_t * new_link = __helios_sched_link(new_node, link_type);
+	if (*ptr == HELIOS_NULL_PTR)
 	{
-		/* Wait Link */
-		if (*ptr == HELIOS_NULL_PTR)
-		{
-			*ptr = new_node;
-			new_node->wait_link.next = new_node;
-			new_node->wait_link.prev = new_node;
-		}
-		else
-		{
-			new_node->wait_link.next = (*ptr)->wait_link.next;
-			new_node->wait_link.prev = *ptr;
-			new_node->wait_link.next->wait_link.prev = new_node;
-			(*ptr)->wait_link.next = new_node;
-		}
+		*ptr = new_node;
+		new_link->next = new_node;
+		new_link->prev = new_node;
 	}
 	else
 	{
-		/* Ready Link */
-		if (*ptr == HELIOS_NULL_PTR)
-		{
-			*ptr = new_node;
-			new_node->ready_link.next = new_node;
-			new_node->ready_link.prev = new_node;
-		}
-		else
-		{
-			new_node->ready_link.next = (*ptr)->ready_link.next;
-			new_node->ready_link.prev = *ptr;
-			new_node->ready_link.next->ready_link.prev = new_node;
-			(*ptr)->ready_link.next = new_node;
-		}
+		link_t * ref_link = __helios_sched_link(*ptr, link_type);
+		new_link->next = ref_link->next;
+		new_link->prev = *ptr;
+		__helios_sched_link(new_link->next, link_type)->prev = new_node;
+		ref_link->next = new_node;
 	}
 	return success;
 }
 
 /**
  * @brief	Insert a node before a reference pointer
+ * @note	When the reference is the head of a ring, this appends
+ *		the node at the tail of the ring.
  *
  * @param	ptr[in_out]	Reference pointer address
  * @param	new_node[in]	Node to be inserted
- * @param 	link_type[in]	HELIOS_LINK_READY / HELIOS_LINK_WAIT
+ * @param 	link_type[in]	HELIOS_LINK_READY / HELIOS_LINK_WAIT / HELIOS_LINK_TASK
  *
  * @return	None
 */
@@ -127,39 +196,20 @@ status_t _helios_sched_insert_before(helios_sched_tcb_t ** ptr, helios_sched_tcb
 	HELIOS_ASSERT_IF_FALSE(ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(new_node != HELIOS_NULL_PTR);
 
-	if (link_type == HELIOS_LINK_WAIT)
+	link_t * new_link = __helios_sched_link(new_node, link_type);
+	if (*ptr == HELIOS_NULL_PTR)
 	{
-		/* Wait Link */
-		if (*ptr == HELIOS_NULL_PTR)
-		{
-			*ptr = new_node;
-			new_node->wait_link.next = new_node;
-			new_node->wait_link.prev = new_node;
-		}
-		else
-		{
-			new_node->wait_link.next = *ptr;
-			new_node->wait_link.prev = (*ptr)->wait_link.prev;
-			(*ptr)->wait_link.prev = new_node;
-			new_node->wait_link.prev->wait_link.next = new_node;
-		}
+		*ptr = new_node;
+		new_link->next = new_node;
+		new_link->prev = new_node;
 	}
 	else
 	{
-		/* Ready Link */
-		if (*ptr == HELIOS_NULL_PTR)
-		{
-			*ptr = new_node;
-			new_node->ready_link.next = new_node;
-			new_node->ready_link.prev = new_node;
-		}
-		else
-		{
-			new_node->ready_link.next = *ptr;
-			new_node->ready_link.prev = (*ptr)->ready_link.prev;
-			(*ptr)->ready_link.prev = new_node;
-			new_node->ready_link.prev->ready_link.next = new_node;
-		}
+		link_t * ref_link = __helios_sched_link(*ptr, link_type);
+		new_link->next = *ptr;
+		new_link->prev = ref_link->prev;
+		ref_link->prev = new_node;
+		__helios_sched_link(new_link->prev, link_type)->next = new_node;
 	}
 	return success;
 }
@@ -167,42 +217,80 @@ status_t _helios_sched_insert_before(helios_sched_tcb_t ** ptr, helios_sched_tcb
 /**
  * @brief	A function to detach an existing node from a link
  *
+ * @param	head[in_out]		Address of the head of the ring
  * @param	node_ptr[in_out]	Address of the node to be detached
- * @param	link_type[in]		HELIOS_LINK_READY / HELIOS_LINK_WAIT
+ * @param	link_type[in]		HELIOS_LINK_READY / HELIOS_LINK_WAIT / HELIOS_LINK_TASK
  *
  * @return	None
  */
-status_t _helios_sched_node_detach(helios_sched_tcb_t *node_ptr, uint8_t link_type)
+status_t _helios_sched_node_detach(helios_sched_tcb_t ** head, helios_sched_tcb_t *node_ptr, uint8_t link_type)
 {
+	HELIOS_ASSERT_IF_FALSE(head != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(node_ptr != HELIOS_NULL_PTR);
 
-	if (link_type == HELIOS_LINK_WAIT)
+	link_t * link = __helios_sched_link(node_ptr, link_type);
+	if (link->next == HELIOS_NULL_PTR)
 	{
-		/* Wait Link */
-		if (node_ptr == g_sched_ctrl.wait_list_head)
-		{
-			g_sched_ctrl.wait_list_head = node_ptr->ready_link.next;
-		}
-		node_ptr->wait_link.prev->wait_link.next = node_ptr->wait_link.next;
-		node_ptr->wait_link.next->wait_link.prev = node_ptr->wait_link.prev;
-		node_ptr->wait_link.prev = node_ptr->wait_link.next = HELIOS_NULL_PTR;
+		/* Node is not linked */
+		return success;
 	}
-	else
+	if (node_ptr == *head)
 	{
-		if (node_ptr == g_sched_ctrl.ready_list_head)
+		/* Move the head ahead, or clear it if the node was the last one */
+		*head = (link->next == node_ptr) ? HELIOS_NULL_PTR : link->next;
+	}
+	__helios_sched_link(link->prev, link_type)->next = link->next;
+	__helios_sched_link(link->next, link_type)->prev = link->prev;
+	link->prev = link->next = HELIOS_NULL_PTR;
+	return success;
+}
+
+/**
+ * @brief	Append a task at the back of its priority FIFO
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	ptr[in_out]		Pointer to task TCB
+ *
+ * @return	None
+ */
+void _helios_sched_ready_enqueue(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr)
+{
+	helios_ready_queue_t * ready_q = &sched_ctrl->ready_q;
+	uint8_t prio = ptr->priority;
+
+	_helios_sched_insert_before(&ready_q->prio_head[prio], ptr, HELIOS_LINK_READY);
+	ready_q->prio_map[prio >> 5] |= (1UL << (prio & 0x1f));
+	ready_q->prio_grp |= (uint8_t)(1U << (prio >> 5));
+}
+
+/**
+ * @brief	Remove a task from its priority FIFO
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	ptr[in_out]		Pointer to task TCB
+ *
+ * @return	None
+ */
+void _helios_sched_ready_dequeue(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr)
+{
+	helios_ready_queue_t * ready_q = &sched_ctrl->ready_q;
+	uint8_t prio = ptr->priority;
+
+	_helios_sched_node_detach(&ready_q->prio_head[prio], ptr, HELIOS_LINK_READY);
+	if (ready_q->prio_head[prio] == HELIOS_NULL_PTR)
+	{
+		ready_q->prio_map[prio >> 5] &= ~(1UL << (prio & 0x1f));
+		if (ready_q->prio_map[prio >> 5] == false)
 		{
-			g_sched_ctrl.ready_list_head = node_ptr->ready_link.next;
+			ready_q->prio_grp &= (uint8_t)~(1U << (prio >> 5));
 		}
-		/* Ready Link */
-		node_ptr->ready_link.prev->ready_link.next = node_ptr->ready_link.next;
-		node_ptr->ready_link.next->ready_link.prev = node_ptr->ready_link.prev;
-		node_ptr->ready_link.prev = node_ptr->ready_link.next = HELIOS_NULL_PTR;
 	}
-	return success;
 }
 
 /**
  * @brief	Send a task to wait state
+ * @note	Waits of HELIOS_DELAY_MAX ticks do not time out and are not
+ *		kept in the delay list, they are resumed by the resource only.
  *
  * @param	sched_ctrl[in_out]	Current scheduler control
  * @param	ptr[in_out]		Pointer to task TCB
@@ -212,14 +300,16 @@ status_t _helios_sched_node_detach(helios_sched_tcb_t *node_ptr, uint8_t link_ty
  */
 void _helios_sched_send_to_wait(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr, const size_t ticks)
 {
-	if (ptr->task_status == helios_sched_task_status_wait)
+	if (ptr->task_status >= helios_sched_task_status_wait)
 	{
 		return;
 	}
-	if(_helios_sched_insert_before(&(sched_ctrl->wait_list_head), ptr, HELIOS_LINK_WAIT) == success)
+	_helios_sched_ready_dequeue(sched_ctrl, ptr);
+	ptr->task_status = helios_sched_task_status_wait;
+	if (ticks != HELIOS_DELAY_MAX)
 	{
-		ptr->wait_res.task_delay_ticks = ticks;
-		ptr->task_status = helios_sched_task_status_wait;
+		ptr->wait_res.wake_tick = HELIOS_DEADLINE(sched_ctrl->tick_count, ticks);
+		__helios_sched_delay_insert(sched_ctrl, ptr);
 	}
 }
 
@@ -233,15 +323,22 @@ void _helios_sched_send_to_wait(helios_sched_ctrl_t * sched_ctrl, helios_sched_t
  */
 void _helios_sched_send_to_pause(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr)
 {
-	if (ptr->task_status == helios_sched_task_status_pause)
+	if ((ptr->task_status == helios_sched_task_status_pause) ||
+	    (ptr->task_status == helios_sched_task_status_exit))
 	{
 		return;
 	}
-	if(_helios_sched_insert_before(&(sched_ctrl->wait_list_head), ptr, HELIOS_LINK_WAIT) == success)
+	if (ptr->task_status == helios_sched_task_status_wait)
 	{
-		ptr->wait_res.task_delay_ticks = HELIOS_DELAY_MAX;
-		ptr->task_status = helios_sched_task_status_pause;
+		_helios_sched_node_detach(&(sched_ctrl->delay_list_head), ptr, HELIOS_LINK_WAIT);
+		/* Resource is retried once the task is resumed */
+		__helios_sched_waiter_detach(ptr);
 	}
+	else
+	{
+		_helios_sched_ready_dequeue(sched_ctrl, ptr);
+	}
+	ptr->task_status = helios_sched_task_status_pause;
 }
 
 /**
@@ -259,23 +356,137 @@ void _helios_sched_send_to_resume(helios_sched_ctrl_t * sched_ctrl, helios_sched
 		return;
 	}
 
-	if (ptr == sched_ctrl->wait_list_head)
+	_helios_sched_node_detach(&(sched_ctrl->delay_list_head), ptr, HELIOS_LINK_WAIT);
+	__helios_sched_waiter_detach(ptr);
+	ptr->task_status = helios_sched_task_status_ready;
+	_helios_sched_ready_enqueue(sched_ctrl, ptr);
+}
+
+/**
+ * @brief	Terminate a task and take it out of the ready/wait queues
+ * @note	The TCB stays on the task list until the IDLE task cleans it up
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	ptr[in_out]		Pointer to task TCB
+ *
+ * @return	None
+ */
+void _helios_sched_send_to_exit(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr)
+{
+	if (ptr->task_status >= helios_sched_task_status_wait)
 	{
-		/* First in the list */
-		sched_ctrl->wait_list_head = ptr->wait_link.next;
-		if (ptr->wait_link.next == ptr && ptr->wait_link.prev == ptr)
-		{
-			/* Last Wait task left */
-			sched_ctrl->wait_list_head = HELIOS_NULL_PTR;
-		}
+		_helios_sched_node_detach(&(sched_ctrl->delay_list_head), ptr, HELIOS_LINK_WAIT);
+		__helios_sched_waiter_detach(ptr);
+	}
+	else if (ptr->task_status != helios_sched_task_status_exit)
+	{
+		_helios_sched_ready_dequeue(sched_ctrl, ptr);
+	}
+	ptr->task_status = helios_sched_task_status_exit;
+}
+
+/**
+ * @brief	Add a task to the waiter list of a resource
+ * @note	Only links the task, caller sends it to wait state
+ *
+ * @param	wait_q[in_out]	Waiter list head of the resource
+ * @param	ptr[in_out]	Pointer to task TCB
+ * @param	resource[in]	Address of the resource
+ * @param	owner[in]	Owner field of the resource, NULL if not owned
+ *
+ * @return	None
+ */
+void _helios_sched_waiter_add(helios_sched_tcb_t ** wait_q, helios_sched_tcb_t * ptr, uintptr_t resource, helios_sched_tcb_t ** owner)
+{
+	ptr->wait_res.wait_on_resource = resource;
+	ptr->wait_res.wait_owner = owner;
+	ptr->wait_res.handoff = false;
+	__helios_sched_waiter_link(wait_q, ptr);
+}
+
+/**
+ * @brief	Hand a resource over to its highest priority waiter
+ * @note	Waiter list is sorted, so the head is taken in constant time.
+ *		Woken task finds wait_res.handoff set and does not retry.
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	wait_q[in_out]		Waiter list head of the resource
+ *
+ * @return	Woken task, NULL if there was no waiter
+ */
+helios_sched_tcb_t * _helios_sched_waiter_wake(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t ** wait_q)
+{
+	helios_sched_tcb_t * ptr = *wait_q;
+	if (ptr == HELIOS_NULL_PTR)
+	{
+		return HELIOS_NULL_PTR;
+	}
+	_helios_sched_send_to_resume(sched_ctrl, ptr);
+	ptr->wait_res.handoff = true;
+	return ptr;
+}
+
+/**
+ * @brief	Change the effective priority of a task
+ * @note	Task is moved to the new priority in the ready queue or in
+ *		the waiter list it is linked to.
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	ptr[in_out]		Pointer to task TCB
+ * @param	priority[in]		New priority
+ *
+ * @return	None
+ */
+void _helios_sched_set_priority(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr, uint8_t priority)
+{
+	helios_sched_tcb_t ** wait_q = ptr->wait_res.wait_q;
+
+	if (ptr->priority == priority)
+	{
+		return;
+	}
+	if (ptr->ready_link.next != HELIOS_NULL_PTR)
+	{
+		_helios_sched_ready_dequeue(sched_ctrl, ptr);
+		ptr->priority = priority;
+		_helios_sched_ready_enqueue(sched_ctrl, ptr);
+	}
+	else if (wait_q != HELIOS_NULL_PTR)
+	{
+		_helios_sched_node_detach(wait_q, ptr, HELIOS_LINK_RES);
+		ptr->priority = priority;
+		__helios_sched_waiter_link(wait_q, ptr);
+	}
+	else
+	{
+		ptr->priority = priority;
+	}
+}
+
+/**
+ * @brief	Raise priority of a resource owner to that of its waiter
+ * @note	Inheritance is carried along the chain of owners which are
+ *		themselves waiting on an owned resource.
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	owner[in_out]		Task owning the resource
+ * @param	priority[in]		Priority of the waiting task
+ *
+ * @return	None
+ */
+void _helios_sched_inherit_priority(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * owner, uint8_t priority)
+{
+	while ((owner != HELIOS_NULL_PTR) && (owner->priority < priority))
+	{
+		_helios_sched_set_priority(sched_ctrl, owner, priority);
+		owner = (owner->wait_res.wait_owner != HELIOS_NULL_PTR) ? *(owner->wait_res.wait_owner) : HELIOS_NULL_PTR;
 	}
-	_helios_sched_node_detach(ptr, HELIOS_LINK_WAIT);
-	ptr->wait_res.task_delay_ticks = false;
-	ptr->task_status = helios_sched_task_status_ready;
 }
 
 /**
  * @brief	Send a task to the back of its own priority list
+ * @note	The FIFO of a priority is a ring, so if the task is at its
+ *		head, moving the head to the next node is enough.
  *
  * @param	node_ptr[in_out]	Pointer to task TCB
  *
@@ -285,51 +496,21 @@ status_t _helios_sched_send_back_of_task_prio(helios_sched_tcb_t *node_ptr)
 {
 	HELIOS_ASSERT_IF_FALSE(node_ptr != HELIOS_NULL_PTR);
 
-	helios_sched_tcb_t * ref_ptr = g_sched_ctrl.ready_list_head;
-	if(ref_ptr != HELIOS_NULL_PTR)
-	{
-		if (node_ptr == ref_ptr)
-		{
-			/* Very first node */
-			return success;
-		}
+	helios_sched_tcb_t ** head = &(g_sched_ctrl.ready_q.prio_head[node_ptr->priority]);
 
-		bool least_prio = true;
-		/* Find an optimal space */
-		while(node_ptr->priority >= ref_ptr->priority)
-		{
-			least_prio = false;
-			ref_ptr = ref_ptr->ready_link.next;
-			if (ref_ptr == g_sched_ctrl.ready_list_head)
-			{
-				/* traversal complete */
-				break;
-			}
-		}
-		if (least_prio)
-		{
-			/* Set ready list head if least prio detected */
-			g_sched_ctrl.ready_list_head = node_ptr;
-		}
-		if(node_ptr->ready_link.next == node_ptr->ready_link.prev)
-		{
-			/**
-			 * New Node
-			 * Insert it behind the same priority
-			 */
-			_helios_sched_insert_before(&ref_ptr, node_ptr, HELIOS_LINK_READY);
-		}
-		else
-		{
-			/**
-			 * Detach the current node from link and insert it at the end
-			 * of priority
-			 * This would help to round robin over the same priority when
-			 * scheduling
-			 */
-			_helios_sched_node_detach(node_ptr, HELIOS_LINK_READY);
-			_helios_sched_insert_before(&ref_ptr, node_ptr, HELIOS_LINK_READY);
-		}
+	if (node_ptr->ready_link.next == HELIOS_NULL_PTR)
+	{
+		/* Not in ready queue */
+		return success;
+	}
+	if (*head == node_ptr)
+	{
+		*head = node_ptr->ready_link.next;
+	}
+	else
+	{
+		_helios_sched_node_detach(head, node_ptr, HELIOS_LINK_READY);
+		_helios_sched_insert_before(head, node_ptr, HELIOS_LINK_READY);
 	}
 	return success;
 }
@@ -344,10 +525,11 @@ status_t _helios_sched_send_back_of_task_prio(helios_sched_tcb_t *node_ptr)
 void _helios_pre_sched(helios_args args)
 {
 	helios_sched_ctrl_t * sched_ctrl = (helios_sched_ctrl_t *) args;
-	sched_ctrl->curr_task->task_status = helios_sched_task_status_ready;
-	__helios_sched_wait_list_adjustment(sched_ctrl);
+	if (sched_ctrl->curr_task->task_status == helios_sched_task_status_running)
+	{
+		sched_ctrl->curr_task->task_status = helios_sched_task_status_ready;
+	}
 	__helios_sched_deadlock_adjustment_and_detection(sched_ctrl);
-	_helios_sched_send_back_of_task_prio(sched_ctrl->curr_task);
 }
 
 /**
@@ -380,39 +562,348 @@ void _helios_scheduler_despatch(void)
 	}
 
 }
+
+/**
+ * @brief	Preempt current task if a higher priority task was woken
+ * @note	From ISR the switch is deferred to irq exit
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	woken[in]		Task made ready
+ *
+ * @return	None
+ */
+void _helios_sched_preempt_check(helios_sched_ctrl_t * sched_ctrl, const helios_sched_tcb_t * woken)
+{
+	if ((sched_ctrl->curr_task == HELIOS_NULL_PTR) || (woken->priority <= sched_ctrl->curr_task->priority))
+	{
+		return;
+	}
+	if (in_isr())
+	{
+		sched_ctrl->preempt_pending = true;
+	}
+	else
+	{
+		_helios_scheduler_despatch();
+	}
+}
+
+/**
+ * @brief	Switch from boot context to the highest priority ready task
+ * @note	Must be called with interrupts disabled, boot context is never resumed
+ *
+ * @return	None
+ */
+void _helios_sched_start(void)
+{
+	static uintptr_t boot_sp;
+	helios_sched_tcb_t * next_task = __helios_sched_highest_ready(&g_sched_ctrl.ready_q);
+
+	if (next_task == HELIOS_NULL_PTR)
+	{
+		HELIOS_SCHED_PANIC(error_os_panic_os_start_fail);
+	}
+	g_sched_ctrl.curr_task = next_task;
+	next_task->task_status = helios_sched_task_status_running;
+	arch_ctx_switch(&boot_sp, next_task->stack_ptr);
+}
+
+#if HELIOS_POWER_SAVE_EN
+/**
+ * @brief	Stretch the tick till the earliest wake up deadline
+ * @note	Called by IDLE task with interrupts disabled. The tick is
+ *		not stretched if any other task is ready to run.
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ *
+ * @return	Ticks the tick is stretched by, 0 if not stretched
+ */
+helios_tick_t _helios_sched_tickless_enter(helios_sched_ctrl_t * sched_ctrl)
+{
+	helios_sched_tcb_t * curr = sched_ctrl->curr_task;
+	helios_tick_t ticks = HELIOS_TICKLESS_MAX;
+
+	if ((__helios_sched_highest_ready(&sched_ctrl->ready_q) != curr) || (curr->ready_link.next != curr))
+	{
+		return false;
+	}
+	if (sched_ctrl->delay_list_head != HELIOS_NULL_PTR)
+	{
+		if (!HELIOS_TICK_AFTER(sched_ctrl->delay_list_head->wait_res.wake_tick, sched_ctrl->tick_count))
+		{
+			return false;
+		}
+		ticks = sched_ctrl->delay_list_head->wait_res.wake_tick - sched_ctrl->tick_count;
+		ticks = (ticks < HELIOS_TICKLESS_MAX) ? ticks : HELIOS_TICKLESS_MAX;
+	}
+	if ((ticks <= 1) || (timer_set_period(ticks * HELIOS_TICK_MS) != success))
+	{
+		return false;
+	}
+	sched_ctrl->sleep_ticks = ticks;
+	return ticks;
+}
+
+/**
+ * @brief	Restore the periodic tick and account the ticks slept
+ * @note	Called with interrupts disabled, either from tick or from
+ *		IDLE task when woken up early by another interrupt.
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	slept[in]		Ticks elapsed since the tick was stretched
+ *
+ * @return	None
+ */
+void _helios_sched_tickless_exit(helios_sched_ctrl_t * sched_ctrl, helios_tick_t slept)
+{
+	if (sched_ctrl->sleep_ticks == false)
+	{
+		/* Already accounted by tick */
+		return;
+	}
+	slept = (slept < sched_ctrl->sleep_ticks) ? slept : sched_ctrl->sleep_ticks;
+	sched_ctrl->sleep_ticks = false;
+	timer_set_period(HELIOS_TICK_MS);
+	sched_ctrl->tick_count += slept;
+	__helios_sched_wake_expired(sched_ctrl);
+}
+#endif /* HELIOS_POWER_SAVE_EN */
+
+/**
+ * @brief	HELIOS tick callback, executed in timer ISR context
+ * @note	Advances the tick count and wakes the timed out tasks. The
+ *		switch is deferred to irq exit so that the timer driver
+ *		completes its ISR on the current stack.
+ *
+ * @return	None
+ */
+void _helios_sched_tick(void)
+{
+#if HELIOS_POWER_SAVE_EN
+	if (g_sched_ctrl.sleep_ticks != false)
+	{
+		/* Stretched tick expired, the whole sleep has elapsed */
+		_helios_sched_tickless_exit(&g_sched_ctrl, g_sched_ctrl.sleep_ticks);
+	}
+	else
+#endif /* HELIOS_POWER_SAVE_EN */
+	{
+		g_sched_ctrl.tick_count++;
+		__helios_sched_wake_expired(&g_sched_ctrl);
+	}
+	g_sched_ctrl.preempt_pending = true;
+}
+
+/**
+ * @brief	HELIOS irq exit hook, executed at the end of every trap
+ *		with interrupts disabled
+ *
+ * @return	None
+ */
+void _helios_sched_irq_exit(void)
+{
+	if ((g_sched_ctrl.preempt_pending == false) || (g_sched_ctrl.curr_task == HELIOS_NULL_PTR))
+	{
+		return;
+	}
+#if HELIOS_POWER_SAVE_EN
+	if (g_sched_ctrl.sleep_ticks != false)
+	{
+		/* IDLE task accounts the sleep and yields once it resumes */
+		return;
+	}
+#endif /* HELIOS_POWER_SAVE_EN */
+	g_sched_ctrl.preempt_pending = false;
+	_helios_scheduler_despatch();
+}
+
+/**
+ * @brief	Block current task on a driver completion wait queue
+ * @note	Called with interrupts disabled. ISR and IDLE task can not
+ *		block, they are left to the caller to wait.
+ *
+ * @param	wait_q[in_out]	Waiter list head owned by the completion
+ *
+ * @return	status_t
+ */
+status_t _helios_completion_block(void ** wait_q)
+{
+	helios_sched_tcb_t * curr = g_sched_ctrl.curr_task;
+
+	if ((curr == HELIOS_NULL_PTR) || (curr == g_sched_ctrl.idle_task) || in_isr())
+	{
+		return error_os_invalid_op;
+	}
+	_helios_sched_waiter_add((helios_sched_tcb_t **) wait_q, curr, (uintptr_t) wait_q, HELIOS_NULL_PTR);
+	_helios_sched_send_to_wait(&g_sched_ctrl, curr, HELIOS_DELAY_MAX);
+	/* Returns once woken and scheduled again */
+	_helios_scheduler_despatch();
+	/* Completion is rechecked by the caller, handoff is not used */
+	curr->wait_res.handoff = false;
+	return success;
+}
+
+/**
+ * @brief	Wake highest priority waiter of a driver completion
+ * @note	Called with interrupts disabled, mostly from ISR
+ *
+ * @param	wait_q[in_out]	Waiter list head owned by the completion
+ *
+ * @return	None
+ */
+void _helios_completion_wake(void ** wait_q)
+{
+	helios_sched_tcb_t * woken = _helios_sched_waiter_wake(&g_sched_ctrl, (helios_sched_tcb_t **) wait_q);
+	if (woken != HELIOS_NULL_PTR)
+	{
+		_helios_sched_preempt_check(&g_sched_ctrl, woken);
+	}
+}
+
 /*****************************************************
  *	STATIC FUNCTION DEFINATIONS
  *****************************************************/
-static void __helios_sched_context_switch(helios_sched_tcb_t * next_task)
+/**
+ * @note	Called with interrupts disabled, either from yield or irq exit.
+ *		The previous task resumes from here once it is scheduled again.
+ */
+static void __helios_sched_context_switch(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * next_task)
 {
+	helios_sched_tcb_t * prev_task = sched_ctrl->curr_task;
+	if (next_task == HELIOS_NULL_PTR)
+	{
+		/* IDLE Task is always ready, hence this is a system error */
+		HELIOS_SCHED_PANIC(error_os_panic_sched_algo_null);
+	}
+	sched_ctrl->curr_task = next_task;
 	next_task->task_status = helios_sched_task_status_running;
+	if (prev_task != next_task)
+	{
+		arch_ctx_switch(&prev_task->stack_ptr, next_task->stack_ptr);
+	}
+}
+
+/**
+ * @brief	Insert a task in the delay list as per its wake tick
+ * @note	Tasks with same wake tick are kept in FIFO order
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ * @param	node[in_out]		Pointer to task TCB
+ *
+ * @return	None
+ */
+static void __helios_sched_delay_insert(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * node)
+{
+	helios_sched_tcb_t * ptr = sched_ctrl->delay_list_head;
+
+	if ((ptr == HELIOS_NULL_PTR) || HELIOS_TICK_AFTER(ptr->wait_res.wake_tick, node->wait_res.wake_tick))
+	{
+		/* Earliest deadline, becomes the new head */
+		_helios_sched_insert_before(&sched_ctrl->delay_list_head, node, HELIOS_LINK_WAIT);
+		sched_ctrl->delay_list_head = node;
+		return;
+	}
+	/* Walk backwards from the tail, as later deadlines are more common */
+	ptr = ptr->wait_link.prev;
+	while (HELIOS_TICK_AFTER(ptr->wait_res.wake_tick, node->wait_res.wake_tick))
+	{
+		ptr = ptr->wait_link.prev;
+	}
+	_helios_sched_insert_after(&ptr, node, HELIOS_LINK_WAIT);
+}
+
+/**
+ * @brief	Insert a task in a resource waiter list as per its priority
+ * @note	Head is the highest priority waiter, tasks with same
+ *		priority are kept in FIFO order
+ *
+ * @param	wait_q[in_out]	Waiter list head of the resource
+ * @param	node[in_out]	Pointer to task TCB
+ *
+ * @return	None
+ */
+static void __helios_sched_waiter_link(helios_sched_tcb_t ** wait_q, helios_sched_tcb_t * node)
+{
+	helios_sched_tcb_t * ptr = *wait_q;
+
+	node->wait_res.wait_q = wait_q;
+	if ((ptr == HELIOS_NULL_PTR) || (ptr->priority < node->priority))
+	{
+		/* Highest priority waiter, becomes the new head */
+		_helios_sched_insert_before(wait_q, node, HELIOS_LINK_RES);
+		*wait_q = node;
+		return;
+	}
+	ptr = ptr->res_link.prev;
+	while (ptr->priority < node->priority)
+	{
+		ptr = ptr->res_link.prev;
+	}
+	_helios_sched_insert_after(&ptr, node, HELIOS_LINK_RES);
+}
+
+/**
+ * @brief	Take a task out of the waiter list it is linked to
+ *
+ * @param	node[in_out]	Pointer to task TCB
+ *
+ * @return	None
+ */
+static void __helios_sched_waiter_detach(helios_sched_tcb_t * node)
+{
+	if (node->wait_res.wait_q == HELIOS_NULL_PTR)
+	{
+		return;
+	}
+	_helios_sched_node_detach(node->wait_res.wait_q, node, HELIOS_LINK_RES);
+	node->wait_res.wait_q = HELIOS_NULL_PTR;
+	node->wait_res.wait_owner = HELIOS_NULL_PTR;
+	node->wait_res.wait_on_resource = false;
 }
 
-static void __helios_sched_deadlock_adjustment_and_detection(const helios_sched_ctrl_t * sched_ctrl _UNUSED)
+/**
+ * @brief	Resume the tasks whose wake tick has been reached
+ * @note	Delay list is sorted, so only the expired heads are visited
+ *
+ * @param	sched_ctrl[in_out]	Current scheduler control
+ *
+ * @return	None
+ */
+static void __helios_sched_wake_expired(helios_sched_ctrl_t * sched_ctrl)
+{
+	helios_sched_tcb_t * ptr = sched_ctrl->delay_list_head;
+	while ((ptr != HELIOS_NULL_PTR) &&
+	       !HELIOS_TICK_AFTER(ptr->wait_res.wake_tick, sched_ctrl->tick_count))
+	{
+		_helios_sched_send_to_resume(sched_ctrl, ptr);
+		ptr = sched_ctrl->delay_list_head;
+	}
+}
+
+static void __helios_sched_deadlock_adjustment_and_detection(helios_sched_ctrl_t * sched_ctrl _UNUSED)
 {
 #if HELIOS_ANTI_DEADLOCK
-	helios_sched_tcb_t * ptr = sched_ctrl->ready_list_head;
+	helios_sched_tcb_t * ptr = sched_ctrl->task_list_head;
 	static helios_sched_anti_deadlock_t anti_deadlock_notify;
 	while (ptr != HELIOS_NULL_PTR)
 	{
-		if (ptr->task_status != helios_sched_task_status_pause)
+		if ((ptr->task_status != helios_sched_task_status_pause) &&
+		    (ptr->task_status != helios_sched_task_status_exit))
 		{
 			ptr->task_wd_ticks--;
-		}
-		if ((ptr->task_wd_ticks == false) && (sched_ctrl->cb_hooks_reg.deadlock_notify != HELIOS_NULL_PTR))
-		{
-			/* Create notification params */
-			anti_deadlock_notify.name = ptr->name;
-			anti_deadlock_notify.task_func = ptr->task_func;
-
-			if (ptr->task_status != helios_sched_task_status_exit)
+			if ((ptr->task_wd_ticks == false) && (sched_ctrl->cb_hooks_reg.deadlock_notify != HELIOS_NULL_PTR))
 			{
-				ptr->task_status = helios_sched_task_status_exit;
+				/* Create notification params */
+				anti_deadlock_notify.name = ptr->name;
+				anti_deadlock_notify.task_func = ptr->task_func;
+
+				_helios_sched_send_to_exit(sched_ctrl, ptr);
+				/* Notify the user that the task pointed by ptr is dead and has been terminated */
+				sched_ctrl->cb_hooks_reg.deadlock_notify((helios_args) &anti_deadlock_notify);
 			}
-			/* Notify the user that the task pointed by ptr is dead and has been terminated */
-			sched_ctrl->cb_hooks_reg.deadlock_notify((helios_args) &anti_deadlock_notify);
 		}
-		if (ptr->ready_link.next == sched_ctrl->ready_list_head)
+		ptr = ptr->task_link.next;
+		if (ptr == sched_ctrl->task_list_head)
 		{
 			break;
 		}
@@ -421,79 +912,45 @@ static void __helios_sched_deadlock_adjustment_and_detection(const helios_sched_
 	return;
 #endif /* HELIOS_ANTI_DEADLOCK */
 }
-static void __helios_sched_wait_list_adjustment(helios_sched_ctrl_t * sched_ctrl)
-{
-	helios_sched_tcb_t * ptr = sched_ctrl->wait_list_head;
-	if (ptr == HELIOS_NULL_PTR)
-	{
-		return;
-	}
-
-	const int * wait_res = (int *)ptr->wait_res.wait_on_resource;
-	while(ptr != HELIOS_NULL_PTR)
-	{
-		if (ptr->task_status == helios_sched_task_status_wait)
-		{
-			ptr->wait_res.task_delay_ticks--;	/* Tick caliberations required */
-
-			if ((wait_res != HELIOS_NULL_PTR) && *wait_res > false)
-			{
-				/* The resource is available can can go to ready state */
-				ptr->wait_res.task_delay_ticks = false;
-				ptr->wait_res.wait_on_resource = false;
-			}
-			if(ptr->wait_res.task_delay_ticks == false)
-			{
-				_helios_sched_send_to_resume(sched_ctrl, ptr);
-			}
-			if (ptr->wait_link.next == sched_ctrl->wait_list_head)
-			{
-				break;
-			}
-			else
-			{
-				ptr = ptr->wait_link.next;
-			}
-		}
-	}
-}
 
 /*****************************************************
  *	SCHEDULER ALGORITHMS
  *****************************************************/
+/**
+ * Round robin walks every ready task irrespective of its priority:
+ * the FIFO of the current priority is walked from head to tail and
+ * then the next lower non-empty priority is picked, wrapping around
+ * to the highest one. Every step is a constant time bitmap lookup.
+ */
 static void __helios_sched_algo_round_robin_fn(helios_sched_ctrl_t * sched_ctrl)
 {
-	/* do waitlist adjustment */
-	helios_sched_tcb_t * ptr = sched_ctrl->curr_task->ready_link.next;
+	helios_sched_tcb_t * curr = sched_ctrl->curr_task;
+	helios_sched_tcb_t * const * head = &(sched_ctrl->ready_q.prio_head[curr->priority]);
+	helios_sched_tcb_t * ptr;
 
-	if (ptr == sched_ctrl->ready_list_head)
+	if (curr->ready_link.next == HELIOS_NULL_PTR)
 	{
-		/* IDLE Task */
-		_helios_sched_send_to_resume(&g_sched_ctrl, ptr);
+		/* Current task left the ready queue, continue with its priority */
+		ptr = (*head != HELIOS_NULL_PTR) ? *head :
+			__helios_sched_next_lower_ready(&sched_ctrl->ready_q, curr->priority);
 	}
-	/* Context switch to next task */
-	if (ptr->task_status == helios_sched_task_status_ready)
+	else if (curr->ready_link.next != *head)
+	{
+		/* Next task of same priority */
+		ptr = curr->ready_link.next;
+	}
+	else
 	{
-		__helios_sched_context_switch(ptr->ready_link.next);
+		/* Tail of the priority reached */
+		ptr = __helios_sched_next_lower_ready(&sched_ctrl->ready_q, curr->priority);
 	}
+	/* Context switch to next task */
+	__helios_sched_context_switch(sched_ctrl, ptr);
 }
 
 static void __helios_sched_algo_priority_driven_fn(helios_sched_ctrl_t * sched_ctrl)
 {
-	/* do waitlist adjustment */
-	helios_sched_tcb_t * ptr = sched_ctrl->ready_list_head->ready_link.prev;
-	if(ptr != HELIOS_NULL_PTR)
-	{
-		while (ptr->task_status != helios_sched_task_status_ready)
-		{
-			ptr = ptr->wait_link.prev;
-			if (ptr == sched_ctrl->ready_list_head)
-			{
-				/* IDLE Task */
-				_helios_sched_send_to_resume(&g_sched_ctrl, ptr);
-				break;
-			}
-		}
-		__helios_sched_context_switch(ptr);
-	}
+	/* Round robin within the same priority */
+	_helios_sched_send_back_of_task_prio(sched_ctrl->curr_task);
+	__helios_sched_context_switch(sched_ctrl, __helios_sched_highest_ready(&sched_ctrl->ready_q));
 }
@@ -21,6 +21,9 @@
  *	GLOBAL EXTERNS
  *****************************************************/
 extern helios_sched_ctrl_t g_sched_ctrl;
+extern void _helios_sched_waiter_add(helios_sched_tcb_t ** wait_q, helios_sched_tcb_t * ptr, uintptr_t resource, helios_sched_tcb_t ** owner);
+extern helios_sched_tcb_t * _helios_sched_waiter_wake(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t ** wait_q);
+extern void _helios_sched_preempt_check(helios_sched_ctrl_t * sched_ctrl, const helios_sched_tcb_t * woken);
 /*****************************************************
  *	STATIC FUNCTION DEFINATIONS
  *****************************************************/
@@ -32,12 +35,12 @@ extern helios_sched_ctrl_t g_sched_ctrl;
 status_t helios_sem_create (helios_sem_t ** sem_ptr, size_t init_val)
 {
 #if HELIOS_DYNAMIC == false
-	HELIOS_ASSERT_IF_FALSE((*sem_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(*sem_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE((*sem_ptr)->sem_init == false);
 #else
 	HELIOS_ASSERT_IF_FALSE(*sem_ptr == HELIOS_NULL_PTR);
 	/* Create semaphore */
-	*sem_ptr = helios_malloc(sizeof(helios_sem_t));
+	*sem_ptr = helios_obj_alloc(helios_obj_sem);
 	if (*sem_ptr == HELIOS_NULL_PTR)
 	{
 		HELIOS_ERR("Memory low for sem create");
@@ -46,6 +49,7 @@ status_t helios_sem_create (helios_sem_t ** sem_ptr, size_t init_val)
 #endif 	/* HELIOS_DYNAMIC */
 	/* Fill up the init details */
 	(*sem_ptr)->sem_val = init_val;
+	(*sem_ptr)->wait_q = HELIOS_NULL_PTR;
 	(*sem_ptr)->sem_init = true;
 
 	return success;
@@ -55,49 +59,94 @@ status_t helios_sem_take (helios_sem_t * sem_ptr, size_t wait_ticks)
 	HELIOS_ASSERT_IF_FALSE(sem_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(sem_ptr->sem_init != false);
 
-	if (sem_ptr->sem_val == false)
+	istate_t istate;
+	status_t ret = success;
+	helios_sched_tcb_t * curr = g_sched_ctrl.curr_task;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	helios_tick_t deadline = HELIOS_DEADLINE(g_sched_ctrl.tick_count, wait_ticks);
+	while (sem_ptr->sem_val == false)
 	{	/* If sem already locked */
-		if (wait_ticks == false) 	/* ||_IS_ISR */
+		if ((wait_ticks == false) || in_isr())
 		{
 			/* If Thread can not wait on resource to get unlocked */
 			HELIOS_ERR("Semaphore already locked");
-			return error_os_sem_get;
+			ret = error_os_sem_get;
+			break;
+		}
+		if ((wait_ticks != HELIOS_DELAY_MAX) && !HELIOS_TICK_AFTER(deadline, g_sched_ctrl.tick_count))
+		{
+			/* Timed out */
+			ret = error_os_sem_get;
+			break;
 		}
-		else
+		/* Queue up as per priority and wait till give or deadline */
+		_helios_sched_waiter_add(&sem_ptr->wait_q, curr, (uintptr_t) sem_ptr, HELIOS_NULL_PTR);
+		helios_task_wait((wait_ticks == HELIOS_DELAY_MAX) ? HELIOS_DELAY_MAX :
+				 (size_t)(deadline - g_sched_ctrl.tick_count));
+		if (curr->wait_res.handoff != false)
 		{
-			/* Set the TCB to point to locked resource */
-			g_sched_ctrl.curr_task->wait_res.wait_on_resource = (uintptr_t) sem_ptr;
-			/* Send to wait state */
-			helios_task_wait(wait_ticks);
+			/* Count was handed over by give, nothing to decrement */
+			curr->wait_res.handoff = false;
+			HELIOS_EXIT_CRITICAL(&istate);
+			return success;
 		}
 	}
-	else
+	if (ret == success)
 	{
-		/* Else Decrement semaphore value */
+		/* Decrement semaphore value */
 		sem_ptr->sem_val--;
 	}
-	return success;
+	HELIOS_EXIT_CRITICAL(&istate);
+	return ret;
 }
 status_t helios_sem_give (helios_sem_t * sem_ptr)
 {
 	HELIOS_ASSERT_IF_FALSE(sem_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE(sem_ptr->sem_init != false);
 
-	/* Increment Semaphore value */
-	sem_ptr->sem_val++;
+	istate_t istate;
+	helios_sched_tcb_t * waiter;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	/* Hand the count directly to the highest priority waiter */
+	waiter = _helios_sched_waiter_wake(&g_sched_ctrl, &sem_ptr->wait_q);
+	if (waiter == HELIOS_NULL_PTR)
+	{
+		/* Increment Semaphore value */
+		sem_ptr->sem_val++;
+	}
+	else
+	{
+		_helios_sched_preempt_check(&g_sched_ctrl, waiter);
+	}
+	HELIOS_EXIT_CRITICAL(&istate);
 
 	return success;
 }
 status_t helios_sem_delete (helios_sem_t ** sem_ptr)
 {
 	HELIOS_ASSERT_IF_FALSE(sem_ptr != HELIOS_NULL_PTR);
+	HELIOS_ASSERT_IF_FALSE(*sem_ptr != HELIOS_NULL_PTR);
 	HELIOS_ASSERT_IF_FALSE((*sem_ptr)->sem_init != false);
 
+	istate_t istate;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	/* Waiters keep pointers into the semaphore */
+	if ((*sem_ptr)->wait_q != HELIOS_NULL_PTR)
+	{
+		HELIOS_EXIT_CRITICAL(&istate);
+		HELIOS_ERR("Semaphore in use, can not delete");
+		return error_os_invalid_op;
+	}
 	(*sem_ptr)->sem_init = false;
+	HELIOS_EXIT_CRITICAL(&istate);
 
 #if HELIOS_DYNAMIC == true
 	/* Free up allocated space */
-	helios_free(*sem_ptr);
+	helios_obj_free(helios_obj_sem, *sem_ptr);
+	*sem_ptr = HELIOS_NULL_PTR;
 #endif
 
 	return success;
@@ -13,11 +13,17 @@
  *****************************************************/
 #include <terravisor/helios/helios.h>
 #include <arch.h>
+#include <time.h>
+#include <driver.h>
 
 /*****************************************************
  *	EXTERN FUNCTION DECLARATION
  *****************************************************/
-extern status_t _helios_sched_node_detach(helios_sched_tcb_t *node_ptr, uint8_t link_type);
+extern status_t _helios_sched_node_detach(helios_sched_tcb_t **head, helios_sched_tcb_t *node_ptr, uint8_t link_type);
+#if HELIOS_POWER_SAVE_EN
+extern helios_tick_t _helios_sched_tickless_enter(helios_sched_ctrl_t * sched_ctrl);
+extern void _helios_sched_tickless_exit(helios_sched_ctrl_t * sched_ctrl, helios_tick_t slept);
+#endif
 
 /*****************************************************
  *	STATIC FUNCTION DECLARATION
@@ -25,30 +31,95 @@ extern status_t _helios_sched_node_detach(helios_sched_tcb_t *node_ptr, uint8_t
 /**
  * @brief	This function cleans up the terminated task form the TCB list
  *
+ * @param  sched_ctrl[in]	Scheduler control
  * @param  ptr[in]		Pointer to the TCB being cleaned
  * @return helios_sched_tcb_t *	Pointer to the next TCB
  */
-static helios_sched_tcb_t * __free_terminated_task(helios_sched_tcb_t * ptr)
+static helios_sched_tcb_t * __free_terminated_task(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr)
 {
-	helios_sched_tcb_t * next_ptr = ptr->ready_link.next;
-	if (ptr->ready_link.next->task_status == helios_sched_task_status_exit)
+	istate_t istate;
+	helios_sched_tcb_t * next_ptr;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	next_ptr = ptr->task_link.next;
+	if (ptr->task_status == helios_sched_task_status_exit)
 	{
-		_helios_sched_node_detach(ptr, false);
+		_helios_sched_node_detach(&sched_ctrl->task_list_head, ptr, HELIOS_LINK_TASK);
 
 #if HELIOS_DYNAMIC == true
-		helios_free((void *)ptr->stack_ptr);
-		helios_free(ptr);
+		helios_free((void *)ptr->stack_base);
+		helios_obj_free(helios_obj_tcb, ptr);
 #endif
 	}
+	HELIOS_EXIT_CRITICAL(&istate);
 
 	return next_ptr;
 }
 
 #if HELIOS_POWER_SAVE_EN
-static void __helios_power_save_callback(void)
+static void __helios_power_save_callback(helios_args args _UNUSED)
 {
 	arch_wfi();
 }
+
+/**
+ * @brief	This function sleeps till the earliest wake up deadline
+ * @note	Tick is stretched only while no other task is ready. When woken
+ *		up early by another interrupt, slept time is measured using the
+ *		terravisor timestamp and accounted to the tick count.
+ *		With HELIOS_DRIVER_PM_EN, drivers supporting runtime PM are
+ *		suspended between pre and post sleep hooks.
+ *
+ * @param  sched_ctrl[in]	Scheduler control
+ * @return None
+ */
+static void __helios_tickless_sleep(helios_sched_ctrl_t * sched_ctrl)
+{
+	istate_t istate;
+	uint64_t t_start, t_end, slept_us;
+	helios_tick_t slept;
+
+	get_timestamp(&t_start);
+	HELIOS_ENTER_CRITICAL(&istate);
+	if (_helios_sched_tickless_enter(sched_ctrl) != false)
+	{
+		if (sched_ctrl->cb_hooks_reg.pre_sleep_cb != HELIOS_NULL_PTR)
+		{
+			sched_ctrl->cb_hooks_reg.pre_sleep_cb((helios_args) sched_ctrl);
+		}
+#if HELIOS_DRIVER_PM_EN
+		/* Veto by a busy driver keeps all drivers running, sleep anyway */
+		driver_suspend_all();
+#endif
+		if (sched_ctrl->cb_hooks_reg.sleep_cb != HELIOS_NULL_PTR)
+		{
+			/* Pending interrupt wakes the core even with interrupts masked */
+			sched_ctrl->cb_hooks_reg.sleep_cb((helios_args) sched_ctrl);
+		}
+#if HELIOS_DRIVER_PM_EN
+		driver_resume_all();
+#endif
+		if (sched_ctrl->cb_hooks_reg.post_sleep_cb != HELIOS_NULL_PTR)
+		{
+			sched_ctrl->cb_hooks_reg.post_sleep_cb((helios_args) sched_ctrl);
+		}
+	}
+	HELIOS_EXIT_CRITICAL(&istate);
+
+	/* Timestamp is read with interrupts enabled as it is lock protected */
+	get_timestamp(&t_end);
+	HELIOS_ENTER_CRITICAL(&istate);
+	if (sched_ctrl->sleep_ticks != false)
+	{
+		/* Woken up early, carry the part tick over to next early wake up */
+		slept_us = (t_end - t_start) + sched_ctrl->sleep_rem_us;
+		slept = (helios_tick_t)(slept_us / (HELIOS_TICK_MS * 1000U));
+		sched_ctrl->sleep_rem_us = (slept < sched_ctrl->sleep_ticks) ?
+			(uint32_t)(slept_us % (HELIOS_TICK_MS * 1000U)) : 0;
+		_helios_sched_tickless_exit(sched_ctrl, slept);
+	}
+	HELIOS_EXIT_CRITICAL(&istate);
+}
 #endif
 /*****************************************************
  *	USER FUNCTION DEFINATION
@@ -57,7 +128,7 @@ _NORETURN void _helios_idle_task_fn(void)
 {
 	static helios_sched_tcb_t * ptr  = HELIOS_NULL_PTR;
 	helios_sched_ctrl_t * sched_ctrl = (helios_sched_ctrl_t *) helios_get_args();
-	ptr = sched_ctrl->ready_list_head;
+	ptr = sched_ctrl->task_list_head;
 #if HELIOS_POWER_SAVE_EN
 	if (sched_ctrl->cb_hooks_reg.sleep_cb == HELIOS_NULL_PTR)
 	{
@@ -67,22 +138,11 @@ _NORETURN void _helios_idle_task_fn(void)
 	while (true)
 	{
 		/* Clean up task if terminated */
-		ptr = __free_terminated_task(ptr);
+		ptr = __free_terminated_task(sched_ctrl, ptr);
 
 #if HELIOS_POWER_SAVE_EN
 		/* Power Save code */
-		if (sched_ctrl->cb_hooks_reg.pre_sleep_cb != HELIOS_NULL_PTR)
-		{
-			sched_ctrl->cb_hooks_reg.pre_sleep_cb();
-		}
-		if (sched_ctrl->cb_hooks_reg.sleep_cb != HELIOS_NULL_PTR)
-		{
-			sched_ctrl->cb_hooks_reg.sleep_cb();
-		}
-		if (sched_ctrl->cb_hooks_reg.post_sleep_cb != HELIOS_NULL_PTR)
-		{
-			sched_ctrl->cb_hooks_reg.post_sleep_cb();
-		}
+		__helios_tickless_sleep(sched_ctrl);
 #endif
 		/* Yield for next available task */
 		helios_task_yield();
@@ -15,12 +15,14 @@
 #include <string.h>
 #include <stdlib.h>
 #include <arch.h>
+#include <interrupt.h>
+#include <terravisor/timer.h>
 #include <terravisor/helios/helios.h>
 
 /*****************************************************
  *	DEFINES
  *****************************************************/
-#define HELIOS_PRIORITY_MAX 255
+#define HELIOS_PRIORITY_MAX	HELIOS_PRIORITY_LEVELS
 
 /*****************************************************
  *	INTERNAL EXTERNS FUNCTIONS
@@ -30,9 +32,15 @@ extern status_t _helios_sched_insert_before(helios_sched_tcb_t **ptr, helios_sch
 extern void _helios_sched_send_to_wait(helios_sched_ctrl_t *sched_ctrl, helios_sched_tcb_t *ptr, const size_t ticks);
 extern void _helios_sched_send_to_pause(helios_sched_ctrl_t * sched_ctrl, helios_sched_tcb_t * ptr);
 extern void _helios_sched_send_to_resume(helios_sched_ctrl_t *sched_ctrl, helios_sched_tcb_t *ptr);
-extern void _helios_sched_send_back_of_task_prio(helios_sched_tcb_t *node_ptr);
+extern void _helios_sched_send_to_exit(helios_sched_ctrl_t *sched_ctrl, helios_sched_tcb_t *ptr);
+extern void _helios_sched_ready_enqueue(helios_sched_ctrl_t *sched_ctrl, helios_sched_tcb_t *ptr);
 extern void _helios_pre_sched(helios_args args);
 extern void _helios_scheduler_despatch(void);
+extern void _helios_sched_start(void);
+extern void _helios_sched_tick(void);
+extern void _helios_sched_irq_exit(void);
+extern status_t _helios_completion_block(void ** wait_q);
+extern void _helios_completion_wake(void ** wait_q);
 /*****************************************************
  *	GLOBAL EXTERNS VARIABLES
  *****************************************************/
@@ -58,6 +66,11 @@ helios_task_t helios_idle_task;
 /*****************************************************
  *	STATIC VARIABLES
  *****************************************************/
+static const completion_ops_t helios_completion_ops =
+{
+	.block = &_helios_completion_block,
+	.wake = &_helios_completion_wake,
+};
 static uint16_t __helios_task_id_gen = false;
 /*****************************************************
  *	STATIC FUNCTION DEFINATIONS
@@ -65,7 +78,8 @@ static uint16_t __helios_task_id_gen = false;
 static void __helios_init_scheduler(void)
 {
 	g_sched_ctrl.cb_hooks_reg.pre_sched = &_helios_pre_sched;
-	g_sched_ctrl.curr_task = g_sched_ctrl.ready_list_head;
+	/* Current task is selected by _helios_sched_start */
+	g_sched_ctrl.curr_task = HELIOS_NULL_PTR;
 	return;
 }
 
@@ -77,16 +91,20 @@ static uint16_t __helios_task_id_generate()
 
 static helios_sched_tcb_t * __helios_get_tcb_using_task_id(const uintptr_t task_id)
 {
-	helios_sched_tcb_t * ptr = g_sched_ctrl.ready_list_head;
+	helios_sched_tcb_t * ptr = g_sched_ctrl.task_list_head;
 	bool _is_id_found = false;
-	while (ptr->ready_link.next != g_sched_ctrl.ready_list_head)
+	while (ptr != HELIOS_NULL_PTR)
 	{
 		if (ptr->task_id == task_id)
 		{
 			_is_id_found = true;
 			break;
 		}
-		ptr = ptr->ready_link.next;
+		ptr = ptr->task_link.next;
+		if (ptr == g_sched_ctrl.task_list_head)
+		{
+			break;
+		}
 	}
 	if (_is_id_found == false)
 	{
@@ -110,6 +128,20 @@ static status_t __helios_set_task_flag(helios_sched_tcb_t* helios_task, helios_t
 	return success;
 }
 
+/**
+ * @brief	Entry of every task context, runs the task function and
+ *		terminates the task if the function returns
+ *
+ * @return	None
+ */
+static void __helios_task_entry(void)
+{
+	g_sched_ctrl.curr_task->task_func();
+	helios_del_task(g_sched_ctrl.curr_task->task_id);
+	/* Exited task is never scheduled again */
+	HELIOS_SCHED_PANIC(error_os_invalid_op);
+}
+
 static bool __helios_is_task_flag(const helios_sched_tcb_t *helios_task, helios_task_flag_t task_flag)
 {
 	if (helios_task != HELIOS_NULL_PTR)
@@ -147,33 +179,38 @@ status_t helios_add_task(
 	HELIOS_ASSERT_IF_FALSE(priority >= HELIOS_IDLE_TASK_PRIORITY);
 	HELIOS_ASSERT_IF_FALSE(priority < HELIOS_PRIORITY_MAX);
 
-	helios_pause_all_task();
-
+	istate_t istate;
 	helios_sched_tcb_t *ptr = HELIOS_NULL_PTR;
 
+	HELIOS_ENTER_CRITICAL(&istate);
+
 #if HELIOS_DYNAMIC == false
 	/* Static Task Allocation */
 	for (size_t i = false; i < HELIOS_MAX_THREAD; i++)
 	{
-		/* Get an available node from global tcb list */
-		if (g_helios_tcb_list[i].task_status == helios_sched_task_status_exit)
+		/* Get an available node (exited and cleaned up) from global tcb list */
+		if ((g_helios_tcb_list[i].task_status == helios_sched_task_status_exit) &&
+		    (g_helios_tcb_list[i].task_link.next == HELIOS_NULL_PTR))
 		{
 			ptr = &(g_helios_tcb_list[i]);
 			break;
 		}
 	}
-	if (ptr != g_sched_ctrl.ready_list_head)
+	if (ptr != HELIOS_NULL_PTR)
 	{
-		ptr->stack_ptr = stack_ptr;
+		memset(ptr, 0, sizeof(helios_sched_tcb_t));
+		ptr->stack_base = stack_ptr;
 #else
 	/* Dynamic Task Declaration */
-	ptr = (helios_sched_tcb_t *)helios_malloc(sizeof(helios_sched_tcb_t));
+	ptr = (helios_sched_tcb_t *)helios_obj_alloc(helios_obj_tcb);
 	if (ptr != HELIOS_NULL_PTR)
 	{
-		ptr->stack_ptr = (uintptr_t)helios_malloc(stack_len);
-		if (ptr->stack_ptr == (uintptr_t)HELIOS_NULL_PTR)
+		memset(ptr, 0, sizeof(helios_sched_tcb_t));
+		ptr->stack_base = (uintptr_t)helios_malloc(stack_len);
+		if (ptr->stack_base == (uintptr_t)HELIOS_NULL_PTR)
 		{
-			helios_resume_all_task();
+			helios_obj_free(helios_obj_tcb, ptr);
+			HELIOS_EXIT_CRITICAL(&istate);
 			HELIOS_ERR("Memory Low for STACK Pointer");
 			return error_memory_low;
 		}
@@ -181,28 +218,29 @@ status_t helios_add_task(
 	}
 	else
 	{
-		helios_resume_all_task();
+		HELIOS_EXIT_CRITICAL(&istate);
 		HELIOS_ERR("Memory Low for Task Creation");
 		return error_memory_low;
 	}
 	/* Fill tcb details */
 	ptr->name = name;
 	ptr->priority = priority;
+	ptr->base_priority = priority;
 	ptr->task_func = task_func;
 	ptr->args_ptr = args;
+	ptr->stack_len = stack_len;
+	ptr->stack_ptr = arch_ctx_init(ptr->stack_base, stack_len, &__helios_task_entry);
 #if HELIOS_ANTI_DEADLOCK
 	ptr->task_wd_ticks = SIZE_MAX;
 #endif /* HELIOS_ANTI_DEADLOCK */
-	if (g_sched_ctrl.ready_list_head == HELIOS_NULL_PTR)
-	{
-		ptr->ready_link.next = ptr->ready_link.prev = g_sched_ctrl.ready_list_head = ptr;
-	}
-	/* Insert Tasks in assending order of its priority */
-	_helios_sched_send_back_of_task_prio(ptr);
+	/* Task list keeps insertion order, IDLE task is added last */
+	_helios_sched_insert_before(&g_sched_ctrl.task_list_head, ptr, HELIOS_LINK_TASK);
+	/* Append Task at the back of its priority FIFO */
+	_helios_sched_ready_enqueue(&g_sched_ctrl, ptr);
 	ptr->task_status = helios_sched_task_status_ready;
 	ptr->task_id = __helios_task_id_generate();
 	*helios_task = ptr->task_id;
-	helios_resume_all_task();
+	HELIOS_EXIT_CRITICAL(&istate);
 	return success;
 }
 
@@ -213,6 +251,7 @@ helios_args helios_get_args(void)
 
 status_t helios_del_task(helios_task_t helios_task)
 {
+	istate_t istate;
 	helios_sched_tcb_t * ptr = __helios_get_tcb_using_task_id(helios_task);
 
 	if (ptr == HELIOS_NULL_PTR)
@@ -220,76 +259,89 @@ status_t helios_del_task(helios_task_t helios_task)
 		ptr = g_sched_ctrl.curr_task;
 	}
 	HELIOS_ASSERT_IF_FALSE(ptr->task_func != &_helios_idle_task_fn);
-	/* Code to handle first node */
-	if (ptr == g_sched_ctrl.ready_list_head)
+	if (ptr == g_sched_ctrl.idle_task)
 	{
 		/* IDLE Task can not be deleted */
 		HELIOS_ERR("Trying to delete IDLE TASK");
 		return error_os_invalid_op;
 	}
-	ptr->task_status = helios_sched_task_status_exit;
+	HELIOS_ENTER_CRITICAL(&istate);
+	_helios_sched_send_to_exit(&g_sched_ctrl, ptr);
 
 	if (ptr == g_sched_ctrl.curr_task)
 	{
 		helios_task_yield(); /* Yeild */
 	}
+	HELIOS_EXIT_CRITICAL(&istate);
 
 	return success;
 }
 
 status_t helios_pause_task(helios_task_t helios_task)
 {
+	istate_t istate;
 	helios_sched_tcb_t *ptr = __helios_get_tcb_using_task_id(helios_task);
 	if (ptr == HELIOS_NULL_PTR)
 	{
 		ptr = g_sched_ctrl.curr_task;
 	}
 
+	HELIOS_ENTER_CRITICAL(&istate);
 	_helios_sched_send_to_pause(&g_sched_ctrl, ptr);
 
+	if (ptr == g_sched_ctrl.curr_task)
+	{
+		helios_task_yield(); /* Yeild */
+	}
+	HELIOS_EXIT_CRITICAL(&istate);
+
 	return success;
 }
 
 status_t helios_pause_all_task(void)
 {
-	helios_sched_tcb_t *ptr = g_sched_ctrl.ready_list_head;
-	if(ptr != HELIOS_NULL_PTR)
+	istate_t istate;
+	helios_sched_tcb_t *ptr = g_sched_ctrl.task_list_head;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	while (ptr != HELIOS_NULL_PTR)
 	{
-		while (true)
+		/* IDLE task and the current task are never paused */
+		if ((ptr != g_sched_ctrl.idle_task) && (ptr != g_sched_ctrl.curr_task))
 		{
-			if (ptr == g_sched_ctrl.curr_task)
-			{
-				/* Do not pause the current task */
-				continue;
-			}
-
 			_helios_sched_send_to_pause(&g_sched_ctrl, ptr);
-			ptr = ptr->ready_link.next;
-
-			if(ptr == g_sched_ctrl.ready_list_head)
-			{
-				break;
-			}
+		}
+		ptr = ptr->task_link.next;
+		if (ptr == g_sched_ctrl.task_list_head)
+		{
+			break;
 		}
 	}
+	HELIOS_EXIT_CRITICAL(&istate);
 
 	return success;
 }
 
 status_t helios_resume_all_task(void)
 {
-	helios_sched_tcb_t *ptr = g_sched_ctrl.ready_list_head;
+	istate_t istate;
+	helios_sched_tcb_t *ptr = g_sched_ctrl.task_list_head;
 	if (ptr != HELIOS_NULL_PTR)
 	{
+		HELIOS_ENTER_CRITICAL(&istate);
 		while (true)
 		{
-			ptr = ptr->ready_link.next;
-			_helios_sched_send_to_resume(&g_sched_ctrl, ptr);
-			if (ptr == g_sched_ctrl.ready_list_head)
+			ptr = ptr->task_link.next;
+			if (ptr->task_status == helios_sched_task_status_pause)
+			{
+				_helios_sched_send_to_resume(&g_sched_ctrl, ptr);
+			}
+			if (ptr == g_sched_ctrl.task_list_head)
 			{
 				break;
 			}
 		}
+		HELIOS_EXIT_CRITICAL(&istate);
 	}
 	else
 	{
@@ -302,19 +354,23 @@ status_t helios_resume_all_task(void)
 
 status_t helios_resume_task(helios_task_t helios_task)
 {
+	istate_t istate;
+	status_t ret = success;
 	helios_sched_tcb_t *ptr = __helios_get_tcb_using_task_id(helios_task);
 	HELIOS_ASSERT_IF_FALSE(ptr != HELIOS_NULL_PTR);
 
-	if (ptr->task_status != helios_sched_task_status_pause)
+	HELIOS_ENTER_CRITICAL(&istate);
+	if (ptr->task_status == helios_sched_task_status_pause)
 	{
 		_helios_sched_send_to_resume(&g_sched_ctrl, ptr);
 	}
 	else
 	{
 		HELIOS_ERR("Invalid call for non-paused task");
-		return error_os_invalid_op;
+		ret = error_os_invalid_op;
 	}
-	return success;
+	HELIOS_EXIT_CRITICAL(&istate);
+	return ret;
 }
 
 status_t helios_set_sched_algo(helios_sched_algo_t sched_algo)
@@ -392,7 +448,7 @@ status_t helios_set_callback(const helios_sched_cb_t cb_type, const helios_cb_ho
 #endif
 	case helios_sched_cb_power_sleep:
 #if HELIOS_POWER_SAVE_EN
-		g_sched_ctrl.cb_hooks_reg.power_sleep = cb_func;
+		g_sched_ctrl.cb_hooks_reg.sleep_cb = cb_func;
 		break;
 #else
 		HELIOS_ERR("Enable HELIOS_POWER_SAVE_EN Flag in build");
@@ -433,24 +489,33 @@ const char *helios_get_task_name(helios_task_t helios_task)
 
 void helios_task_wait(const size_t ticks)
 {
+	istate_t istate;
 	helios_sched_tcb_t *ptr = g_sched_ctrl.curr_task;
 
+	HELIOS_ENTER_CRITICAL(&istate);
 	if (ticks > false)
 	{
 		_helios_sched_send_to_wait(&g_sched_ctrl, ptr, ticks);
 	}
 
 	helios_task_yield();
+	HELIOS_EXIT_CRITICAL(&istate);
 }
 
 void helios_task_yield()
 {
+	istate_t istate;
+
+	HELIOS_ENTER_CRITICAL(&istate);
+	/* Returns when this task is scheduled again */
 	_helios_scheduler_despatch();
+	HELIOS_EXIT_CRITICAL(&istate);
 	return;
 }
 
  _NORETURN void helios_run(void)
 {
+	istate_t istate;
 	/* OS Init code */
 	/* Initialise IDLE Task */
 	helios_add_task(&helios_idle_task,
@@ -460,11 +525,25 @@ void helios_task_yield()
 		       HELIOS_IDLE_TASK_PRIORITY,
 		       HELIOS_IDLE_TASK_STACK_LEN,
 		       (uintptr_t)_helios_stack);
+	g_sched_ctrl.idle_task = __helios_get_tcb_using_task_id(helios_idle_task);
 
 	/* Initialise scheduler */
 	__helios_init_scheduler();
+	/*
+	 * Only global enable is masked, arch_di would also clear
+	 * per source enables (eg mie.MEIE) which no one sets again.
+	 * Boot context is never resumed, so state is not restored.
+	 */
+	HELIOS_ENTER_CRITICAL(&istate);
+	arch_register_irq_exit_hook(&_helios_sched_irq_exit);
+	/* Drivers waiting on irq block only the calling task from now */
+	completion_register_ops(&helios_completion_ops);
+	if (timer_link_callback(HELIOS_TICK_MS, &_helios_sched_tick) != success)
+	{
+		HELIOS_ERR("Tick source unavailable, running cooperatively");
+	}
 	HELIOS_DBG("Starting HELIOS");
-	helios_task_yield(); /* Yeild */
+	_helios_sched_start();
 	HELIOS_SCHED_PANIC(error_os_panic_os_start_fail);
 	while (true)
 	{